@@ -0,0 +1,79 @@
+#include "Lexeme.h"
+#include "Token.h"
+#include "Preprocessor.h"
+#include "PseudoSentence.h"
+#include "RawSentence.h"
+#include "Sentence.h"
+#include "Arena.h"
+#include "Exception.h"
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+string generateForwardBranches(size_t branchCount) {
+    const size_t spans[] = {1, 4, 16, 64, 256};
+
+    std::ostringstream source;
+    source << "CODE SEGMENT\n";
+
+    for (size_t i = 0; i < branchCount; ++i) {
+        size_t target = std::min(i + spans[i % (sizeof(spans) / sizeof(spans[0]))], branchCount);
+
+        source << "L" << i << ":\n";
+        source << "    JBE L" << target << "\n";
+
+        if (i % 4 == 0)
+            source << "    MOV [EAX+ECX*4+10], EBX\n";
+    }
+
+    source << "L" << branchCount << ":\n";
+    source << "    DAA\n";
+    source << "CODE ENDS\n";
+    source << "END\n";
+
+    return source.str();
+}
+
+int main(int argc, char *argv[]) {
+    size_t branchCount = (argc > 1) ? std::stoul(argv[1]) : 100000;
+
+    string source = generateForwardBranches(branchCount);
+
+    Arena arena;
+    Arena::Scope arenaScope(arena);
+
+    try {
+        auto lexemes = constructLexemeContainerVector(source);
+        auto upperLexemes = convertLexemeContainerVectorToUpperCase(lexemes);
+        auto tokens = constructTokenContainerVector(upperLexemes);
+        auto preprocessed = preprocess(tokens);
+        auto pseudoSentences = splitPseudoSentences(get<0>(preprocessed));
+        auto rawSentences = constructRawSentences(get<0>(pseudoSentences), get<1>(pseudoSentences));
+
+        auto start = std::chrono::steady_clock::now();
+        auto sentences = constructSentences(rawSentences);
+        auto end = std::chrono::steady_clock::now();
+
+        size_t shortCount = 0;
+        size_t nearCount = 0;
+        for (auto it = sentences[0].sentences.begin(); it != sentences[0].sentences.end(); ++it) {
+            const InstructionSentence *instructionSentence = it->getIf<InstructionSentence>();
+
+            if (instructionSentence && (instructionSentence->instruction == InstructionNS::Instruction::JBE)) {
+                if (instructionSentence->encodedSize() == 2)
+                    ++shortCount;
+                else
+                    ++nearCount;
+            }
+        }
+
+        std::cout << branchCount << " forward branches: "
+                  << std::chrono::duration<double>(end - start).count() * 1e3 << " ms, "
+                  << shortCount << " short, " << nearCount << " near" << std::endl;
+    } catch (CompileError &e) {
+        std::cerr << "compile error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
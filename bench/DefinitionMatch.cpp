@@ -0,0 +1,85 @@
+#include "Instruction.h"
+#include <chrono>
+#include <iostream>
+
+using namespace OperandMask;
+using namespace InstructionNS;
+
+struct Probe {
+    Instruction instruction;
+    vector<Mask> masks;
+};
+
+const vector<Probe> probeVector = {
+    {Instruction::DAA,  {}},
+    {Instruction::NOT,  {EAX}},
+    {Instruction::NOT,  {CL}},
+    {Instruction::PUSH, {MEM32 | MEM_32 | MEM_32_BASE_EBX}},
+    {Instruction::POP,  {ECX}},
+    {Instruction::OR,   {AL, MEM8 | MEM_16_BX_SI}},
+    {Instruction::OR,   {EAX, IMM | S32}},
+    {Instruction::MOV,  {MEM32 | MEM_32_BASE_EBP | MEM_32_INDEX_ECX | MEM_32_INDEX_MULT4, EDX}},
+    {Instruction::MOV,  {MEM8 | MEM_16_BP_DI, BH}},
+    {Instruction::JBE,  {REL8}}
+};
+
+inline bool bitsetMatch(const bitset<64> &base, const bitset<64> &mask) {
+    return !((base & mask) ^ mask).any();
+}
+
+template<typename MatchFunc>
+size_t countMatches(MatchFunc matchFunc) {
+    size_t matches = 0;
+
+    for (auto it = probeVector.begin(); it != probeVector.end(); ++it) {
+        for (auto jt = instructionDefinitionVector.begin(); jt != instructionDefinitionVector.end(); ++jt) {
+            if ((it->instruction != jt->instruction) || (it->masks.size() != jt->operandFullMasks.size()))
+                continue;
+
+            bool isSuitable = true;
+            for (size_t i = 0; i < it->masks.size(); ++i) {
+                if (!matchFunc(jt->operandFullMasks[i].mask, it->masks[i])) {
+                    isSuitable = false;
+                    break;
+                }
+            }
+
+            if (isSuitable)
+                ++matches;
+        }
+    }
+
+    return matches;
+}
+
+template<typename MatchFunc>
+void run(const string &name, size_t iterations, MatchFunc matchFunc) {
+    volatile size_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+        sink = sink + countMatches(matchFunc);
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double probes = double(iterations) * probeVector.size();
+
+    std::cout << name << ": " << iterations << " iterations, "
+              << seconds * 1e3 << " ms, "
+              << probes / seconds / 1e6 << " Mprobes/s, "
+              << sink / iterations << " matches/iteration" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    size_t iterations = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+
+    run("Mask", iterations, [](Mask base, Mask mask) {
+        return base.match(mask);
+    });
+
+    run("bitset<64>", iterations, [](Mask base, Mask mask) {
+        return bitsetMatch(base.to_ullong(), mask.to_ullong());
+    });
+
+    return 0;
+}
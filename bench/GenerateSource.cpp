@@ -0,0 +1,15 @@
+#include "SourceGenerator.h"
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <lines> [seed]" << std::endl;
+        return 1;
+    }
+
+    size_t lineCount = std::stoul(argv[1]);
+    uint32_t seed = (argc > 2) ? std::stoul(argv[2]) : 1;
+
+    std::cout << SourceGenerator(seed).generate(lineCount);
+
+    return 0;
+}
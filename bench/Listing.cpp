@@ -0,0 +1,83 @@
+#include "Lexeme.h"
+#include "Token.h"
+#include "Preprocessor.h"
+#include "PseudoSentence.h"
+#include "RawSentence.h"
+#include "Sentence.h"
+#include "EncodedSegment.h"
+#include "ListingWriter.h"
+#include "OutputFile.h"
+#include "Arena.h"
+#include "Exception.h"
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+string generateListingSource(size_t lineCount) {
+    size_t blockCount = lineCount / 8;
+
+    std::ostringstream source;
+    source << "DATA1 SEGMENT\n";
+    for (size_t i = 0; i < blockCount; ++i)
+        source << "  D" << i << " DD " << i << ", 10\n";
+    source << "DATA1 ENDS\n";
+
+    source << "CODE SEGMENT\n";
+    source << "ASSUME DS:DATA1\n";
+    for (size_t i = 0; i < blockCount; ++i) {
+        source << "  L" << i << ": MOV [EAX+ECX*4+" << i % 100 << "], EBX\n";
+        source << "  OR AL, [EBX+ESI*2]\n";
+        source << "  PUSH D" << i << "\n";
+        source << "  JBE L" << i << "\n";
+        source << "  POP ECX\n";
+        source << "  NOT EBX\n";
+        source << "  DAA\n";
+    }
+    source << "CODE ENDS\n";
+    source << "END\n";
+
+    return source.str();
+}
+
+int main(int argc, char *argv[]) {
+    size_t lineCount = (argc > 1) ? std::stoul(argv[1]) : 200000;
+    string listingFilePath = (argc > 2) ? argv[2] : "/dev/null";
+
+    string source = generateListingSource(lineCount);
+
+    Arena arena;
+    Arena::Scope arenaScope(arena);
+
+    try {
+        auto lexemes = constructLexemeContainerVector(source);
+        auto upperLexemes = convertLexemeContainerVectorToUpperCase(lexemes);
+        auto tokens = constructTokenContainerVector(upperLexemes);
+        auto preprocessed = preprocess(tokens);
+        auto pseudoSentences = splitPseudoSentences(get<0>(preprocessed));
+        auto rawSentences = constructRawSentences(get<0>(pseudoSentences), get<1>(pseudoSentences));
+        auto sentences = constructSentences(rawSentences);
+        auto encodedSegments = encodeSegments(sentences);
+
+        size_t sentenceCount = 0;
+        for (auto it = sentences.begin(); it != sentences.end(); ++it)
+            sentenceCount += it->sentences.size();
+
+        auto start = std::chrono::steady_clock::now();
+        OutputFile listingFile(listingFilePath);
+        ListingWriter listingWriter(listingFile);
+        listingWriter.write(sentences, encodedSegments, pseudoSentences);
+        listingWriter.flush();
+        listingFile.close();
+        auto end = std::chrono::steady_clock::now();
+
+        double seconds = std::chrono::duration<double>(end - start).count();
+        std::cout << sentenceCount << " listing lines: "
+                  << seconds * 1e3 << " ms, "
+                  << sentenceCount / seconds / 1e6 << " Mlines/s" << std::endl;
+    } catch (CompileError &e) {
+        std::cerr << "compile error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
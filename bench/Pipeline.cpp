@@ -0,0 +1,121 @@
+#include "SourceGenerator.h"
+#include "Lexeme.h"
+#include "Token.h"
+#include "Preprocessor.h"
+#include "PseudoSentence.h"
+#include "RawSentence.h"
+#include "Sentence.h"
+#include "EncodedSegment.h"
+#include "ListingWriter.h"
+#include "OutputFile.h"
+#include "Arena.h"
+#include "Exception.h"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+void resetPeakRss() {
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+}
+
+size_t peakRssKiB() {
+    std::ifstream status("/proc/self/status");
+    string line;
+
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0)
+            return std::stoul(line.substr(6));
+    }
+
+    return 0;
+}
+
+class PhaseRunner {
+public:
+    PhaseRunner(size_t lineCount) :
+        lineCount(lineCount),
+        totalTime(0),
+        maxPeakRss(0)
+    {}
+
+    template<typename F>
+    auto run(const char *name, F &&func) -> decltype(func()) {
+        resetPeakRss();
+        auto start = std::chrono::steady_clock::now();
+        auto result = func();
+        double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        size_t peakRss = peakRssKiB();
+        print(name, time, peakRss);
+        totalTime += time;
+        maxPeakRss = std::max(maxPeakRss, peakRss);
+
+        return result;
+    }
+
+    void printTotal() {
+        print("total", totalTime, maxPeakRss);
+    }
+private:
+    void print(const char *name, double time, size_t peakRss) {
+        std::cout << std::setw(10) << lineCount << "  "
+                  << std::left << std::setw(16) << name << std::right
+                  << std::setw(12) << std::fixed << std::setprecision(2) << time * 1e3
+                  << std::setw(14) << std::setprecision(0) << lineCount / time
+                  << std::setw(12) << std::setprecision(1) << peakRss / 1024.0 << std::endl;
+    }
+
+    size_t lineCount;
+    double totalTime;
+    size_t maxPeakRss;
+};
+
+int main(int argc, char *argv[]) {
+    vector<size_t> lineCounts;
+    for (int i = 1; i < argc; ++i)
+        lineCounts.push_back(std::stoul(argv[i]));
+
+    if (lineCounts.empty())
+        lineCounts = {1000, 10000, 100000, 1000000};
+
+    std::cout << "optimization: " << TAS_BENCH_OPT << std::endl;
+    std::cout << std::setw(10) << "lines" << "  "
+              << std::left << std::setw(16) << "phase" << std::right
+              << std::setw(12) << "ms"
+              << std::setw(14) << "lines/s"
+              << std::setw(12) << "peak MiB" << std::endl;
+
+    for (auto it = lineCounts.begin(); it != lineCounts.end(); ++it) {
+        string source = SourceGenerator().generate(*it);
+
+        Arena arena;
+        Arena::Scope arenaScope(arena);
+        PhaseRunner runner(*it);
+
+        try {
+            auto lexemes = runner.run("lex", [&] { return constructLexemeContainerVector(source); });
+            auto upperLexemes = runner.run("uppercase", [&] { return convertLexemeContainerVectorToUpperCase(lexemes); });
+            auto tokens = runner.run("tokenize", [&] { return constructTokenContainerVector(upperLexemes); });
+            auto preprocessed = runner.run("preprocess", [&] { return preprocess(tokens); });
+            auto pseudoSentences = runner.run("split", [&] { return splitPseudoSentences(get<0>(preprocessed)); });
+            auto rawSentences = runner.run("raw sentences", [&] { return constructRawSentences(get<0>(pseudoSentences), get<1>(pseudoSentences)); });
+            auto sentences = runner.run("sentences", [&] { return constructSentences(rawSentences); });
+            auto encoded = runner.run("encode", [&] { return encodeSegments(sentences); });
+            runner.run("listing", [&] {
+                OutputFile listingFile("/dev/null");
+                ListingWriter listingWriter(listingFile);
+                listingWriter.write(sentences, encoded, pseudoSentences);
+                listingWriter.flush();
+                return true;
+            });
+            runner.printTotal();
+        } catch (CompileError &e) {
+            std::cerr << "compile error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,153 @@
+#ifndef _SOURCEGENERATOR_H_
+#define _SOURCEGENERATOR_H_
+
+#include "Global.h"
+#include <sstream>
+
+class SourceGenerator {
+public:
+    static constexpr size_t linesPerSegment = 4096;
+    static constexpr size_t equCount = 16;
+
+    inline SourceGenerator(uint32_t seed = 1) :
+        state(seed)
+    {}
+
+    inline string generate(size_t lineCount) {
+        std::ostringstream source;
+        size_t lines = 0;
+
+        for (size_t i = 0; i < equCount; ++i) {
+            if (i == 0)
+                source << "C0 EQU " << next(256) << "\n";
+            else
+                source << "C" << i << " EQU C" << next(i) << "+" << next(64) << "\n";
+            ++lines;
+        }
+
+        size_t bodyLines = (lines + 1 < lineCount) ? (lineCount - 1 - lines) : 0;
+        size_t groupCount = std::max<size_t>((bodyLines + 3 * linesPerSegment - 1) / (3 * linesPerSegment), 1);
+        size_t segmentLength = (bodyLines + 3 * groupCount - 1) / (3 * groupCount);
+
+        for (size_t segIndex = 0; lines + 1 < lineCount; ++segIndex) {
+            size_t segmentLines = std::min(segmentLength, lineCount - 1 - lines);
+
+            if (segIndex % 3 == 0)
+                lines += generateDataSegment(source, segIndex, segmentLines);
+            else
+                lines += generateCodeSegment(source, segIndex, segmentLines);
+        }
+
+        source << "END\n";
+
+        return source.str();
+    }
+private:
+    inline size_t next(size_t bound) {
+        state = state * 1103515245 + 12345;
+        return (state >> 8) % bound;
+    }
+
+    inline string equName() {
+        return "C" + std::to_string(next(equCount));
+    }
+
+    inline size_t generateDataSegment(std::ostringstream &source, size_t segIndex, size_t lineCount) {
+        const char *directives[] = {"DB", "DW", "DD"};
+
+        source << "DATA" << segIndex << " SEGMENT\n";
+
+        size_t lines = 2;
+        for (size_t i = 0; lines < lineCount; ++i, ++lines) {
+            size_t directive = next(3);
+            size_t operands = next(4);
+            if ((directive == 0) && (operands != 1))
+                directive = 1 + next(2);
+
+            source << "  D" << segIndex << "_" << i << " " << directives[directive] << " ";
+            switch (operands) {
+            case 0:
+                source << next(100) << ", " << equName();
+                break;
+            case 1:
+                source << (directive == 0 ? "'text', 0" : "1234H, 5678H");
+                break;
+            case 2:
+                source << equName() << "*2, " << next(100);
+                break;
+            default:
+                source << next(128);
+                break;
+            }
+            source << "\n";
+        }
+
+        source << "DATA" << segIndex << " ENDS\n";
+
+        return lines;
+    }
+
+    inline size_t generateCodeSegment(std::ostringstream &source, size_t segIndex, size_t lineCount) {
+        const char *instructions[] = {
+            "DAA",
+            "NOT AL",
+            "NOT EBX",
+            "PUSH DWORD PTR [EAX+ECX*4+10]",
+            "POP ECX",
+            "OR AL, [EBX+ESI*2]",
+            "OR EAX, [EDI+20]",
+            "MOV [ESP+5], AL",
+            "MOV DWORD PTR [BX+SI+3], EDX",
+            "MOV GS:[EAX+300], EBX"
+        };
+
+        source << "CODE" << segIndex << " SEGMENT\n";
+
+        const size_t maxJumpDistance = std::min<size_t>(std::max<size_t>(lineCount * 3 / 128, 12), 96);
+        const size_t minFarJumpDistance = maxJumpDistance / 3;
+
+        size_t lines = 2;
+        size_t labelCount = 0;
+        size_t targetCount = 0;
+        while (lines + 1 + (targetCount - labelCount) < lineCount) {
+            size_t kind = next(16);
+
+            if ((kind < 2) && (lines + 8 < lineCount)) {
+                source << "IF " << equName() << " GT " << next(256) << "\n";
+                source << "  IF " << equName() << " LT " << next(256) << "\n";
+                source << "    DAA\n";
+                source << "  ELSE\n";
+                source << "    NOT AL\n";
+                source << "  ENDIF\n";
+                source << "ELSE\n";
+                source << "  POP ECX\n";
+                source << "ENDIF\n";
+                lines += 9;
+            } else if ((kind < 5) && (lines + 2 + maxJumpDistance < lineCount)) {
+                size_t distance = (next(8) == 0) ? (next(maxJumpDistance - minFarJumpDistance) + minFarJumpDistance) : (next(8) + 1);
+                source << "L" << segIndex << "_" << labelCount << ":\n";
+                source << "  JBE L" << segIndex << "_" << (labelCount + distance) << "\n";
+                ++labelCount;
+                targetCount = std::max(targetCount, labelCount + distance + 1);
+                lines += 2;
+            } else {
+                source << "  " << instructions[next(sizeof(instructions) / sizeof(instructions[0]))] << "\n";
+                ++lines;
+            }
+        }
+
+        for (; labelCount < targetCount; ++labelCount, ++lines)
+            source << "L" << segIndex << "_" << labelCount << ":\n";
+
+        source << "  DAA\n";
+        ++lines;
+
+        source << "CODE" << segIndex << " ENDS\n";
+
+        return lines;
+    }
+
+    uint32_t state;
+};
+
+#endif
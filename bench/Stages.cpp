@@ -0,0 +1,190 @@
+#include "SourceGenerator.h"
+#include "Lexeme.h"
+#include "Token.h"
+#include "Preprocessor.h"
+#include "PseudoSentence.h"
+#include "RawSentence.h"
+#include "Sentence.h"
+#include "Math.h"
+#include "ByteEmitter.h"
+#include "Arena.h"
+#include "Exception.h"
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+class StageResult {
+public:
+    string name;
+    size_t itemCount;
+    vector<double> times;
+};
+
+template<typename T>
+void doNotOptimize(const T &value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+class StageRunner {
+public:
+    StageRunner(size_t warmupCount, size_t repetitionCount) :
+        warmupCount(warmupCount),
+        repetitionCount(repetitionCount)
+    {}
+
+    template<typename F>
+    void run(const char *name, size_t itemCount, F &&func) {
+        StageResult result = {name, itemCount, {}};
+
+        for (size_t i = 0; i < warmupCount + repetitionCount; ++i) {
+            Arena arena;
+            Arena::Scope arenaScope(arena);
+
+            auto start = std::chrono::steady_clock::now();
+            auto output = func();
+            auto end = std::chrono::steady_clock::now();
+            doNotOptimize(output);
+
+            if (i >= warmupCount)
+                result.times.push_back(std::chrono::duration<double>(end - start).count());
+        }
+
+        results.push_back(std::move(result));
+    }
+
+    void print(std::ostream &stream, size_t lineCount) const {
+        stream << std::fixed << std::setprecision(6);
+        stream << "{\n";
+        stream << "  \"optimization\": \"" << TAS_BENCH_OPT << "\",\n";
+        stream << "  \"lines\": " << lineCount << ",\n";
+        stream << "  \"warmup\": " << warmupCount << ",\n";
+        stream << "  \"repetitions\": " << repetitionCount << ",\n";
+        stream << "  \"benchmarks\": [";
+
+        for (auto it = results.begin(); it != results.end(); ++it) {
+            vector<double> times = it->times;
+            std::sort(times.begin(), times.end());
+
+            double mean = 0;
+            for (auto jt = times.begin(); jt != times.end(); ++jt)
+                mean += *jt;
+            mean /= times.size();
+
+            double variance = 0;
+            for (auto jt = times.begin(); jt != times.end(); ++jt)
+                variance += (*jt - mean) * (*jt - mean);
+            variance /= times.size();
+
+            double median = (times.size() % 2) ? times[times.size() / 2] : (times[times.size() / 2 - 1] + times[times.size() / 2]) / 2;
+
+            stream << ((it == results.begin()) ? "\n" : ",\n");
+            stream << "    {\"name\": \"" << it->name << "\", "
+                   << "\"items\": " << it->itemCount << ", "
+                   << "\"min_ms\": " << times.front() * 1e3 << ", "
+                   << "\"median_ms\": " << median * 1e3 << ", "
+                   << "\"mean_ms\": " << mean * 1e3 << ", "
+                   << "\"stddev_ms\": " << std::sqrt(variance) * 1e3 << ", "
+                   << "\"max_ms\": " << times.back() * 1e3 << ", "
+                   << "\"items_per_second\": " << std::setprecision(0) << it->itemCount / median << std::setprecision(6) << "}";
+        }
+
+        stream << "\n  ]\n";
+        stream << "}\n";
+    }
+private:
+    size_t warmupCount;
+    size_t repetitionCount;
+    vector<StageResult> results;
+};
+
+vector<vector<MathOperation>> generateMathExpressions(size_t expressionCount) {
+    vector<vector<MathOperation>> expressions;
+    CodePosition pos = {0, 0, 0};
+
+    for (size_t i = 0; i < expressionCount; ++i) {
+        expressions.push_back({
+            {MathOperationKind::BRACKET_OPEN, Integer(), pos},
+            {MathOperationKind::CONSTANT, Integer(int(i % 1000)), pos},
+            {MathOperationKind::ADD, Integer(), pos},
+            {MathOperationKind::CONSTANT, Integer(17), pos},
+            {MathOperationKind::BRACKET_CLOSE, Integer(), pos},
+            {MathOperationKind::MULTIPLY, Integer(), pos},
+            {MathOperationKind::CONSTANT, Integer(int(i % 7 + 1)), pos},
+            {MathOperationKind::SUBTRACT, Integer(), pos},
+            {MathOperationKind::CONSTANT, Integer(int(i % 100)), pos},
+            {MathOperationKind::DIVIDE, Integer(), pos},
+            {MathOperationKind::CONSTANT, Integer(3), pos}
+        });
+    }
+
+    return expressions;
+}
+
+int main(int argc, char *argv[]) {
+    size_t lineCount = (argc > 1) ? std::stoul(argv[1]) : 10000;
+    size_t repetitionCount = (argc > 2) ? std::stoul(argv[2]) : 10;
+    size_t warmupCount = (argc > 3) ? std::stoul(argv[3]) : 2;
+
+    string source = SourceGenerator().generate(lineCount);
+
+    Arena arena;
+    Arena::Scope arenaScope(arena);
+
+    try {
+        auto sourceLexemes = constructLexemeContainerVector(source);
+        auto lexemes = convertLexemeContainerVectorToUpperCase(sourceLexemes);
+        auto tokens = constructTokenContainerVector(lexemes);
+        auto preprocessed = preprocess(tokens);
+        auto pseudoSentences = splitPseudoSentences(get<0>(preprocessed));
+        auto rawSentences = constructRawSentences(get<0>(pseudoSentences), get<1>(pseudoSentences));
+        auto sentences = constructSentences(rawSentences);
+        auto mathExpressions = generateMathExpressions(lineCount);
+
+        vector<const InstructionSentence *> instructionSentences;
+        for (auto it = sentences.begin(); it != sentences.end(); ++it) {
+            for (auto jt = it->sentences.begin(); jt != it->sentences.end(); ++jt) {
+                const InstructionSentence *instructionSentence = jt->getIf<InstructionSentence>();
+
+                if (instructionSentence)
+                    instructionSentences.push_back(instructionSentence);
+            }
+        }
+
+        size_t tokenCount = 0;
+        for (auto it = get<0>(preprocessed).begin(); it != get<0>(preprocessed).end(); ++it)
+            tokenCount += it->tokenContainers.size();
+
+        size_t sentenceCount = 0;
+        for (auto it = rawSentences.begin(); it != rawSentences.end(); ++it)
+            sentenceCount += it->rawSentences.size();
+
+        StageRunner runner(warmupCount, repetitionCount);
+
+        runner.run("constructLexemeContainerVector", lineCount, [&] { return constructLexemeContainerVector(source); });
+        runner.run("constructTokenContainerVector", lexemes.size(), [&] { return constructTokenContainerVector(lexemes); });
+        runner.run("preprocess", tokens.size(), [&] { return preprocess(tokens); });
+        runner.run("splitPseudoSentences", tokenCount, [&] { return splitPseudoSentences(get<0>(preprocessed)); });
+        runner.run("constructRawSentences", sentenceCount, [&] { return constructRawSentences(get<0>(pseudoSentences), get<1>(pseudoSentences)); });
+        runner.run("constructSentences", sentenceCount, [&] { return constructSentences(rawSentences); });
+        runner.run("mathExpressionComputer", mathExpressions.size(), [&] {
+            Integer sum;
+            for (auto it = mathExpressions.begin(); it != mathExpressions.end(); ++it)
+                sum += mathExpressionComputer(*it);
+            return sum;
+        });
+        runner.run("InstructionSentence::encode", instructionSentences.size(), [&] {
+            ByteEmitter emitter;
+            for (auto it = instructionSentences.begin(); it != instructionSentences.end(); ++it)
+                (*it)->encode(emitter);
+            return emitter.size();
+        });
+
+        runner.print(std::cout, lineCount);
+    } catch (CompileError &e) {
+        std::cerr << "compile error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include "AllocStats.h"
+
+#ifdef TAS_ALLOC_STATS
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<size_t> globalAllocationCount(0);
+std::atomic<size_t> globalAllocatedBytes(0);
+std::atomic<size_t> globalLiveBytes(0);
+std::atomic<size_t> globalPeakLiveBytes(0);
+
+constexpr size_t headerSize = alignof(max_align_t);
+
+void *allocate(size_t size) {
+    void *block = std::malloc(size + headerSize);
+    if (!block)
+        return nullptr;
+
+    *static_cast<size_t *>(block) = size;
+
+    globalAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    globalAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    size_t currentLiveBytes = globalLiveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+
+    size_t currentPeak = globalPeakLiveBytes.load(std::memory_order_relaxed);
+    while ((currentLiveBytes > currentPeak) &&
+           (!globalPeakLiveBytes.compare_exchange_weak(currentPeak, currentLiveBytes, std::memory_order_relaxed)))
+    {}
+
+    return static_cast<uchar *>(block) + headerSize;
+}
+
+void *allocateOrThrow(size_t size) {
+    while (true) {
+        void *ptr = allocate(size);
+        if (ptr)
+            return ptr;
+
+        std::new_handler handler = std::get_new_handler();
+        if (!handler)
+            throw std::bad_alloc();
+
+        handler();
+    }
+}
+
+void deallocate(void *ptr) {
+    if (!ptr)
+        return;
+
+    void *block = static_cast<uchar *>(ptr) - headerSize;
+    globalLiveBytes.fetch_sub(*static_cast<size_t *>(block), std::memory_order_relaxed);
+
+    std::free(block);
+}
+
+}
+
+void *operator new(size_t size) {
+    return allocateOrThrow(size);
+}
+
+void *operator new[](size_t size) {
+    return allocateOrThrow(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+    return allocate(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+    return allocate(size);
+}
+
+void operator delete(void *ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+    deallocate(ptr);
+}
+
+bool AllocStats::isEnabled() {
+    return true;
+}
+
+AllocStats AllocStats::snapshot() {
+    return {
+        globalAllocationCount.load(std::memory_order_relaxed),
+        globalAllocatedBytes.load(std::memory_order_relaxed),
+        globalLiveBytes.load(std::memory_order_relaxed),
+        globalPeakLiveBytes.load(std::memory_order_relaxed)
+    };
+}
+
+void AllocStats::resetPeak() {
+    globalPeakLiveBytes.store(globalLiveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+#else
+
+bool AllocStats::isEnabled() {
+    return false;
+}
+
+AllocStats AllocStats::snapshot() {
+    return {0, 0, 0, 0};
+}
+
+void AllocStats::resetPeak() {
+}
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef _ALLOCSTATS_H_
+#define _ALLOCSTATS_H_
+
+#include "Global.h"
+
+class AllocStats {
+public:
+    size_t allocationCount;
+    size_t allocatedBytes;
+    size_t liveBytes;
+    size_t peakLiveBytes;
+
+    static bool isEnabled();
+    static AllocStats snapshot();
+    static void resetPeak();
+};
+
+#endif
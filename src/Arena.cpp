@@ -0,0 +1,60 @@
+#include "Arena.h"
+
+#include <cassert>
+
+thread_local Arena *Arena::currentArena = nullptr;
+
+Arena::Arena(size_t blockSize) :
+    blockSize(blockSize),
+    currentBlock(0),
+    blockOffset(0),
+    _bytesUsed(0),
+    destructors(nullptr)
+{}
+
+Arena::~Arena() {
+    reset();
+}
+
+void *Arena::allocate(size_t size, size_t alignment) {
+    while (true) {
+        for (; currentBlock < blocks.size(); ++currentBlock) {
+            Block &block = blocks[currentBlock];
+            size_t alignedOffset = (blockOffset + alignment - 1) & ~(alignment - 1);
+
+            if (alignedOffset + size <= block.size) {
+                blockOffset = alignedOffset + size;
+                _bytesUsed += size;
+
+                return block.data.get() + alignedOffset;
+            }
+
+            blockOffset = 0;
+        }
+
+        size_t newBlockSize = std::max(blockSize, size + alignment);
+        blocks.push_back({std::unique_ptr<uchar[]>(new uchar[newBlockSize]), newBlockSize});
+        currentBlock = blocks.size() - 1;
+    }
+}
+
+void Arena::registerDestructor(void *object, void (*destructor)(void *)) {
+    DestructorRecord *record = static_cast<DestructorRecord *>(allocate(sizeof(DestructorRecord), alignof(DestructorRecord)));
+    *record = {destructor, object, destructors};
+    destructors = record;
+}
+
+void Arena::reset() {
+    for (DestructorRecord *record = destructors; record != nullptr; record = record->next)
+        record->destructor(record->object);
+
+    destructors = nullptr;
+    currentBlock = 0;
+    blockOffset = 0;
+    _bytesUsed = 0;
+}
+
+Arena &Arena::current() {
+    assert((currentArena != nullptr) && "arena allocation outside of an Arena::Scope");
+    return *currentArena;
+}
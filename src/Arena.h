@@ -0,0 +1,121 @@
+#ifndef _ARENA_H_
+#define _ARENA_H_
+
+#include "Global.h"
+#include "ScopedCurrent.h"
+#include <new>
+#include <type_traits>
+
+class Arena {
+public:
+    static constexpr size_t defaultBlockSize = 64 * 1024;
+
+    Arena(size_t blockSize = defaultBlockSize);
+    ~Arena();
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    void *allocate(size_t size, size_t alignment);
+
+    template<typename T, typename... Args>
+    inline T *create(Args &&... args) {
+        T *object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+
+        if (!std::is_trivially_destructible<T>::value)
+            registerDestructor(object, destroy<T>);
+
+        return object;
+    }
+
+    void reset();
+
+    inline size_t blockCount() const {
+        return blocks.size();
+    }
+
+    inline size_t bytesUsed() const {
+        return _bytesUsed;
+    }
+
+    static Arena &current();
+
+    class Scope : public ScopedCurrent<Arena *> {
+    public:
+        inline Scope(Arena &arena) :
+            ScopedCurrent(currentArena, &arena)
+        {}
+    };
+private:
+    struct Block {
+        std::unique_ptr<uchar[]> data;
+        size_t size;
+    };
+
+    struct DestructorRecord {
+        void (*destructor)(void *);
+        void *object;
+        DestructorRecord *next;
+    };
+
+    template<typename T>
+    static void destroy(void *object) {
+        static_cast<T *>(object)->~T();
+    }
+
+    void registerDestructor(void *object, void (*destructor)(void *));
+
+    const size_t blockSize;
+    vector<Block> blocks;
+    size_t currentBlock;
+    size_t blockOffset;
+    size_t _bytesUsed;
+    DestructorRecord *destructors;
+
+    static thread_local Arena *currentArena;
+};
+
+template<typename T>
+class ArenaAllocator {
+public:
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    inline ArenaAllocator() noexcept :
+        arena(&Arena::current())
+    {}
+
+    inline ArenaAllocator(Arena &arena) noexcept :
+        arena(&arena)
+    {}
+
+    template<typename U>
+    inline ArenaAllocator(const ArenaAllocator<U> &allocator) noexcept :
+        arena(allocator.arena)
+    {}
+
+    inline T *allocate(size_t n) {
+        return static_cast<T *>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    inline void deallocate(T *, size_t) noexcept
+    {}
+
+    Arena *arena;
+};
+
+template<typename T, typename U>
+inline bool operator==(const ArenaAllocator<T> &allocator1, const ArenaAllocator<U> &allocator2) {
+    return allocator1.arena == allocator2.arena;
+}
+
+template<typename T, typename U>
+inline bool operator!=(const ArenaAllocator<T> &allocator1, const ArenaAllocator<U> &allocator2) {
+    return allocator1.arena != allocator2.arena;
+}
+
+template<typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+#endif
@@ -0,0 +1,62 @@
+#include "Assembler.h"
+
+#include "Lexeme.h"
+#include "Exception.h"
+#include "Token.h"
+#include "Preprocessor.h"
+#include "PseudoSentence.h"
+#include "RawSentence.h"
+#include "EncodedSegment.h"
+#include "Arena.h"
+
+AssembleResult assemble(const char *source, size_t length, const AssembleOptions &options) {
+    AssembleResult result;
+
+    Compiler::ArchScope archScope(options.arch);
+    Arena arena;
+    Arena::Scope arenaScope(arena);
+
+    try {
+        string sourceContents(source, length);
+
+        TokenCache::TokensPtr phase3 = options.tokenCache ? options.tokenCache->find(sourceContents) : nullptr;
+        if (!phase3) {
+            auto phase1 = constructLexemeContainerVector(sourceContents);
+            auto phase2 = convertLexemeContainerVectorToUpperCase(phase1);
+            phase3 = std::make_shared<const vector<TokenContainer>>(constructTokenContainerVector(phase2));
+
+            if (options.tokenCache)
+                options.tokenCache->insert(sourceContents, phase3);
+        }
+
+        auto phase4 = preprocess(*phase3);
+        auto phase5 = splitPseudoSentences(get<0>(phase4));
+        checkPublicLabels(get<3>(phase4), get<1>(phase5));
+        auto phase6 = constructRawSentences(get<0>(phase5), get<1>(phase5));
+        auto phase7 = constructSentences(phase6, options.origin, true);
+        auto phase8 = encodeSegments(phase7, true);
+
+        map<string, size_t> segIndexMap;
+        for (auto it = phase8.begin(); it != phase8.end(); ++it) {
+            segIndexMap[it->segName] = result.segments.size();
+            result.segments.push_back({it->segName, vector<uchar>(it->data(), it->data() + it->size()), it->relocations});
+        }
+
+        const map<string, Label> &labelMap = get<1>(phase5);
+        for (auto it = labelMap.begin(); it != labelMap.end(); ++it) {
+            auto segIndexIt = segIndexMap.find(it->second.segName);
+
+            if (segIndexIt != segIndexMap.end())
+                result.symbols.push_back({it->first, it->second.segName, phase8[segIndexIt->second].offset(it->second.ptr)});
+        }
+
+        result.entryLabel = get<2>(phase4);
+        result.isSucceeded = true;
+    } catch (CompileError &e) {
+        result.diagnostics.push_back({e.what(), e.pos()});
+    } catch (std::exception &e) {
+        result.diagnostics.push_back({e.what(), nullopt});
+    }
+
+    return result;
+}
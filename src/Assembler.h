@@ -0,0 +1,48 @@
+#ifndef _ASSEMBLER_H_
+#define _ASSEMBLER_H_
+
+#include "Global.h"
+#include "Compiler.h"
+#include "CodePosition.h"
+#include "Sentence.h"
+#include "TokenCache.h"
+
+class AssembleOptions {
+public:
+    Compiler::Arch arch = Compiler::Arch::X86_32;
+    size_t origin = 0;
+    TokenCache *tokenCache = nullptr;
+};
+
+class AssembledSegment {
+public:
+    string name;
+    vector<uchar> bytes;
+    vector<Relocation> relocations;
+};
+
+class AssembledSymbol {
+public:
+    string name;
+    string segName;
+    size_t offset;
+};
+
+class AssembleDiagnostic {
+public:
+    string message;
+    optional<CodePosition> pos;
+};
+
+class AssembleResult {
+public:
+    bool isSucceeded = false;
+    vector<AssembledSegment> segments;
+    vector<AssembledSymbol> symbols;
+    optional<string> entryLabel;
+    vector<AssembleDiagnostic> diagnostics;
+};
+
+AssembleResult assemble(const char *source, size_t length, const AssembleOptions &options = AssembleOptions());
+
+#endif
@@ -0,0 +1,48 @@
+#include "Batch.h"
+
+#include "Diagnostics.h"
+#include "ThreadPool.h"
+#include <sstream>
+
+bool compileBatch(const vector<BatchJob> &jobs, size_t threadCount) {
+    class JobResult {
+    public:
+        std::ostringstream out;
+        std::ostringstream err;
+        bool isSucceeded = false;
+        bool isFinished = false;
+    };
+
+    vector<JobResult> results(jobs.size());
+    std::mutex mutex;
+    size_t printedCount = 0;
+    bool isSucceeded = true;
+
+    ThreadPool threadPool(std::min(threadCount, jobs.size()));
+
+    threadPool.parallelFor(jobs.size(), [&](size_t index) {
+        JobResult &result = results[index];
+
+        {
+            DiagnosticStreams::Scope diagnosticScope(result.out, result.err);
+            result.isSucceeded = Compiler().compile(jobs[index].sourceFilePath, jobs[index].options);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        result.isFinished = true;
+
+        for (; (printedCount < results.size()) && results[printedCount].isFinished; ++printedCount) {
+            JobResult &printedResult = results[printedCount];
+
+            if (printedResult.out.tellp() > 0)
+                cout << jobs[printedCount].sourceFilePath << ":" << endl << printedResult.out.str() << std::flush;
+            if (printedResult.err.tellp() > 0)
+                std::cerr << jobs[printedCount].sourceFilePath << ":" << endl << printedResult.err.str() << std::flush;
+
+            if (!printedResult.isSucceeded)
+                isSucceeded = false;
+        }
+    });
+
+    return isSucceeded;
+}
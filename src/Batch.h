@@ -0,0 +1,15 @@
+#ifndef _BATCH_H_
+#define _BATCH_H_
+
+#include "Global.h"
+#include "Compiler.h"
+
+class BatchJob {
+public:
+    string sourceFilePath;
+    CompileOptions options;
+};
+
+bool compileBatch(const vector<BatchJob> &jobs, size_t threadCount);
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef _BYTEEMITTER_H_
+#define _BYTEEMITTER_H_
+
+#include "Global.h"
+#include <initializer_list>
+
+class ByteEmitter {
+public:
+    inline ByteEmitter(bool isRecordingFields = false) :
+        isRecordingFields(isRecordingFields)
+    {}
+
+    inline void emitField(std::initializer_list<uchar> field) {
+        beginField();
+        bytes.insert(bytes.end(), field);
+    }
+
+    inline uchar *emitField(size_t size) {
+        beginField();
+        bytes.resize(bytes.size() + size);
+
+        return bytes.data() + bytes.size() - size;
+    }
+
+    inline void append(const ByteEmitter &emitter) {
+        if (isRecordingFields) {
+            for (auto it = emitter.fieldOffsets.begin(); it != emitter.fieldOffsets.end(); ++it)
+                fieldOffsets.push_back(bytes.size() + *it);
+        }
+
+        bytes.insert(bytes.end(), emitter.bytes.begin(), emitter.bytes.end());
+    }
+
+    inline void clear() {
+        bytes.clear();
+        fieldOffsets.clear();
+    }
+
+    inline size_t size() const {
+        return bytes.size();
+    }
+
+    inline uchar *data() {
+        return bytes.data();
+    }
+
+    inline const uchar *data() const {
+        return bytes.data();
+    }
+
+    inline size_t fieldCount() const {
+        return fieldOffsets.size();
+    }
+
+    inline size_t fieldBegin(size_t field) const {
+        return fieldOffsets[field];
+    }
+
+    inline size_t fieldEnd(size_t field) const {
+        return (field + 1 < fieldOffsets.size()) ? fieldOffsets[field + 1] : bytes.size();
+    }
+private:
+    inline void beginField() {
+        if (isRecordingFields)
+            fieldOffsets.push_back(bytes.size());
+    }
+
+    bool isRecordingFields;
+    vector<uchar> bytes;
+    vector<size_t> fieldOffsets;
+};
+
+#endif
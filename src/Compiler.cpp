@@ -8,45 +8,169 @@
 #include "PseudoSentence.h"
 #include "RawSentence.h"
 #include "Sentence.h"
+#include "EncodedSegment.h"
+#include "OutputWriter.h"
+#include "OutputFile.h"
+#include "ListingWriter.h"
+#include "PhaseTimer.h"
+#include "Trace.h"
+#include "Stats.h"
+#include "Arena.h"
+#include "ThreadPool.h"
+#include "LineIndex.h"
 #include <fstream>
 
-const Compiler::Arch Compiler::arch = Arch::X86_32;
+thread_local Compiler::Arch Compiler::arch = Arch::X86_32;
 
-Compiler::Compiler() {
+template<typename T, typename F>
+size_t countItems(const vector<T> &segmentVector, F segmentItemCount) {
+    size_t itemCount = 0;
+    for (auto it = segmentVector.begin(); it != segmentVector.end(); ++it)
+        itemCount += segmentItemCount(*it);
+
+    return itemCount;
 }
 
-void Compiler::compile(const string &sourceFilePath) const {
+bool Compiler::compile(const string &sourceFilePath, const CompileOptions &options) const {
+    ArchScope archScope(options.arch);
+
+    PhaseReport report(options.isTimeReporting || options.allocReportFilePath,
+                       (options.threadPool && (options.threadPool->threadCount() > 1)) ? CLOCK_PROCESS_CPUTIME_ID : CLOCK_THREAD_CPUTIME_ID);
+    Trace trace;
+    Trace::Scope traceScope(options.traceFilePath ? &trace : nullptr);
+    Stats stats;
+    Stats::Scope statsScope(options.isPrintingStats ? &stats : nullptr);
+    bool isSucceeded = true;
+
     try {
         std::ifstream sourceFile(sourceFilePath);
         if (!sourceFile.is_open())
             throw Exception(string("File \'") + sourceFilePath + "\' not found, or permission denied");
 
         string sourceFileContents((std::istreambuf_iterator<char>(sourceFile)), std::istreambuf_iterator<char>());
+        LineIndex lineIndex(sourceFileContents);
+
+        Arena arena;
+        Arena::Scope arenaScope(arena);
 
         try {
-            auto phase1 = constructLexemeContainerVector(sourceFileContents);
-            auto phase2 = convertLexemeContainerVectorToUpperCase(phase1);
-            auto phase3 = constructTokenContainerVector(phase2);
+            auto phase1 = report.measure("lex", [&] { return constructLexemeContainerVector(sourceFileContents); });
+            report.setItemCount(phase1.size(), "lexemes");
+            auto phase2 = report.measure("uppercase", [&] { return convertLexemeContainerVectorToUpperCase(phase1); });
+            report.setItemCount(phase2.size(), "lexemes");
+            auto phase3 = report.measure("tokenize", [&] { return constructTokenContainerVector(phase2); });
+            report.setItemCount(phase3.size(), "tokens");
             //printTokenTable(phase3, phase2); //LEXICAL ANALYZER
-            auto phase4 = preprocess(phase3);
-            auto phase5 = splitPseudoSentences(get<0>(phase4));
-            auto phase6 = constructRawSentences(get<0>(phase5), get<1>(phase5));
+            auto phase4 = report.measure("preprocess", [&] { return preprocess(phase3); });
+            report.setItemCount(countItems(get<0>(phase4), [](const TokenSegment &segment) { return segment.tokenContainers.size(); }), "tokens");
+            auto phase5 = report.measure("split", [&] { return splitPseudoSentences(get<0>(phase4)); });
+            checkPublicLabels(get<3>(phase4), get<1>(phase5));
+            report.setItemCount(countItems(get<0>(phase5), [](const PseudoSentencesSegment &segment) { return segment.pseudoSentences.size(); }), "sentences");
+            auto phase6 = report.measure("raw sentences", [&] { return constructRawSentences(get<0>(phase5), get<1>(phase5)); });
+            report.setItemCount(countItems(phase6, [](const RawSentencesSegment &segment) { return segment.rawSentences.size(); }), "sentences");
             //printRawSentenceTable(phase6, get<1>(phase5), true); //SYNTATICAL ANALYZER
-            auto phase7 = constructSentences(phase6);
-            printListing(phase7, phase5); //LISTING
+            size_t origin = options.origin ? *options.origin : ((options.outputFormat == CompileOptions::OutputFormat::COM) ? 0x100 : 0);
+            bool isRelocatable = (options.outputFormat == CompileOptions::OutputFormat::ELF) || (options.outputFormat == CompileOptions::OutputFormat::OMF);
+            auto phase7 = report.measure("sentences", [&] { return constructSentences(phase6, origin, isRelocatable); });
+            report.setItemCount(countItems(phase7, [](const SentencesSegment &segment) { return segment.sentences.size(); }), "sentences");
+
+            if (!options.isCheckOnly) {
+                auto phase8 = report.measure("encode", [&] { return encodeSegments(phase7, isRelocatable, options.threadPool); });
+                report.setItemCount(countItems(phase8, [](const EncodedSegment &segment) { return segment.size(); }), "bytes");
+
+                for (auto it = phase8.begin(); it != phase8.end(); ++it)
+                    stats.segmentBytes.push_back(make_tuple(it->segName, it->size()));
+
+                if (options.listingFilePath) {
+                    PhaseTimer timer(report, "listing");
+
+                    if (*options.listingFilePath == "-")
+                        printListing(phase7, phase8, phase5); //LISTING
+                    else {
+                        OutputFile listingFile(*options.listingFilePath);
+                        ListingWriter listingWriter(listingFile);
+                        listingWriter.write(phase7, phase8, phase5);
+                        listingWriter.flush();
+                        listingFile.close();
+                    }
+                }
+
+                if (options.outputFormat != CompileOptions::OutputFormat::NONE) {
+                    PhaseTimer timer(report, "output");
+
+                    switch (options.outputFormat) {
+                    case CompileOptions::OutputFormat::NONE:
+                        break;
+                    case CompileOptions::OutputFormat::BIN:
+                        if (phase8.size() > 1)
+                            throw Exception("Flat binary image must contain a single segment, use ELF, OMF or MZ output for several segments");
+                        writeFlatBinary(phase8, options.outputFilePath);
+                        break;
+                    case CompileOptions::OutputFormat::COM:
+                        if (phase8.size() > 1)
+                            throw Exception("COM image must contain a single segment");
+                        writeFlatBinary(phase8, options.outputFilePath);
+                        break;
+                    case CompileOptions::OutputFormat::ELF:
+                        writeElfObject(phase8, get<1>(phase5), get<3>(phase4), options.outputFilePath);
+                        break;
+                    case CompileOptions::OutputFormat::OMF:
+                        writeOmfObject(phase8, get<1>(phase5), get<3>(phase4), get<2>(phase4), options.outputFilePath);
+                        break;
+                    case CompileOptions::OutputFormat::MZ:
+                        writeMzExecutable(phase8, get<1>(phase5), get<2>(phase4), options.outputFilePath);
+                        break;
+                    }
+                }
+            }
         } catch (CompileError &e) {
-            printCompileError(e.what(), sourceFileContents, e.pos());
+            printCompileError(e.what(), lineIndex, e.pos(), options.isReportingOffsets);
+            isSucceeded = false;
         }
     } catch (std::exception &e) {
         printError(e.what());
+        isSucceeded = false;
+    }
+
+    if (options.isPrintingStats)
+        printStats(stats);
+
+    if (options.isTimeReporting)
+        printTimeReport(report);
+
+    if (options.allocReportFilePath) {
+        try {
+            if (*options.allocReportFilePath == "-")
+                printAllocationReport(report, DiagnosticStreams::out());
+            else {
+                std::ofstream allocReportFile(*options.allocReportFilePath);
+                if (!allocReportFile.is_open())
+                    throw Exception(string("Can not open file \'") + *options.allocReportFilePath + "\' for writing");
+
+                printAllocationReport(report, allocReportFile);
+            }
+        } catch (std::exception &e) {
+            printError(e.what());
+            isSucceeded = false;
+        }
+    }
+
+    if (options.traceFilePath) {
+        try {
+            std::ofstream traceFile(*options.traceFilePath);
+            if (!traceFile.is_open())
+                throw Exception(string("Can not open file \'") + *options.traceFilePath + "\' for writing");
+
+            trace.write(traceFile);
+        } catch (std::exception &e) {
+            printError(e.what());
+            isSucceeded = false;
+        }
     }
-}
 
-Compiler &Compiler::instance() {
-    static Compiler compiler;
-    return compiler;
+    return isSucceeded;
 }
 
-void Compile(const string &sourceFilePath) {
-    Compiler::instance().compile(sourceFilePath);
+bool Compile(const string &sourceFilePath, const CompileOptions &options) {
+    return Compiler().compile(sourceFilePath, options);
 }
@@ -2,6 +2,10 @@
 #define _COMPILER_H_
 
 #include "Global.h"
+#include "ScopedCurrent.h"
+
+class CompileOptions;
+class ThreadPool;
 
 class Compiler {
 public:
@@ -11,16 +15,44 @@ public:
         X86_32
     };
 
-    void compile(const string &sourceFilePath) const;
-    static Compiler &instance();
+    class ArchScope : public ScopedCurrent<Arch> {
+    public:
+        inline ArchScope(Arch arch) :
+            ScopedCurrent(Compiler::arch, arch)
+        {}
+    };
+
+    bool compile(const string &sourceFilePath, const CompileOptions &options) const;
+
+    static thread_local Arch arch;
+};
+
+class CompileOptions {
+public:
+    enum class OutputFormat
+    {
+        NONE,
+        BIN,
+        COM,
+        ELF,
+        OMF,
+        MZ
+    };
 
-    static const Arch arch;
-private:
-    Compiler();
-    Compiler(const Compiler &) = delete;
-    Compiler &operator=(const Compiler &) = delete;
+    Compiler::Arch arch = Compiler::Arch::X86_32;
+    OutputFormat outputFormat = OutputFormat::NONE;
+    string outputFilePath;
+    optional<string> listingFilePath;
+    bool isCheckOnly = false;
+    bool isReportingOffsets = false;
+    bool isTimeReporting = false;
+    bool isPrintingStats = false;
+    optional<string> allocReportFilePath;
+    optional<string> traceFilePath;
+    optional<size_t> origin;
+    ThreadPool *threadPool = nullptr;
 };
 
-void Compile(const string &sourceFilePath);
+bool Compile(const string &sourceFilePath, const CompileOptions &options = CompileOptions());
 
 #endif
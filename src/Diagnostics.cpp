@@ -1,8 +1,8 @@
 #include "Diagnostics.h"
 
+#include "ListingWriter.h"
 #include <iostream>
 #include <iomanip>
-#include <sstream>
 
 const map<Token::Type, string> tokenTypeDescriptionMap = {
     {Token::Type::USER_IDENTIFIER, "User Identifier"},
@@ -22,67 +22,77 @@ const map<Token::Type, string> tokenTypeDescriptionMap = {
     {Token::Type::SIZE_OPERATOR, "Size Operator"},
     {Token::Type::EQU_DIRECTIVE, "EQU Directive"},
     {Token::Type::END_DIRECTIVE, "END Directive"},
-    {Token::Type::ASSUME_DIRECTIVE, "ASSUME Directive"}
+    {Token::Type::ASSUME_DIRECTIVE, "ASSUME Directive"},
+    {Token::Type::PUBLIC_DIRECTIVE, "PUBLIC Directive"}
 };
 
+thread_local std::ostream *DiagnosticStreams::currentOut = nullptr;
+thread_local std::ostream *DiagnosticStreams::currentErr = nullptr;
+
+std::ostream &DiagnosticStreams::out() {
+    return currentOut ? *currentOut : cout;
+}
+
+std::ostream &DiagnosticStreams::err() {
+    return currentErr ? *currentErr : std::cerr;
+}
+
 void printError(string text) {
-    cout << Color::BWhite << text << Color::Reset << endl;
+    std::ostream &stream = DiagnosticStreams::out();
+    stream << Color::BWhite << text << Color::Reset << endl;
 }
 
-void printCompileError(string text, const string &sourceFileContents, CodePosition pos) {
-    cout << Color::BWhite << flush;
+void printCompileError(string text, const LineIndex &lineIndex, CodePosition pos, bool isReportingOffset) {
+    const string &sourceFileContents = lineIndex.contents();
+    std::ostream &stream = DiagnosticStreams::out();
+
+    stream << Color::BWhite << flush;
 
-    cout << Color::BRed << "Compile Error" << Color::BWhite << " ("
-         << pos.row << ":"
-         << pos.column << "): "
-         << text << endl;
+    stream << Color::BRed << "Compile Error" << Color::BWhite << " (";
+    if (isReportingOffset)
+        stream << "offset " << lineIndex.offset(pos);
+    else
+        stream << pos.row << ":" << pos.column;
+    stream << "): " << text << endl;
 
     size_t i;
     size_t j;
 
-    i = 0;
-    size_t currentRow = 1;
-    while (currentRow < pos.row) {
-        if ((sourceFileContents[i] == cCR) || (sourceFileContents[i] == cLF))
-            ++currentRow;
-        if ((sourceFileContents[i] == cCR) && (sourceFileContents[i + 1] == cLF))
-            ++i;
-        ++i;
-    }
+    size_t lineStartIndex = lineIndex.lineBegin(pos.row);
+    size_t lineEndIndex = lineIndex.lineEnd(pos.row);
 
-    size_t lineStartIndex = i;
-    
+    i = lineStartIndex;
     j = 1;
-    while ((sourceFileContents[i] != cCR) && (sourceFileContents[i] != cLF) && (i < sourceFileContents.size())) {
+    while (i < lineEndIndex) {
         if (j == pos.column)
-            cout << Color::BRed << flush;
+            stream << Color::BRed << flush;
         else if (j == pos.column + pos.length)
-            cout << Color::BWhite << flush;
+            stream << Color::BWhite << flush;
 
         if (sourceFileContents[i] == 0x9)
-            cout << "    ";
+            stream << "    ";
         else
-            cout << sourceFileContents[i];
+            stream << sourceFileContents[i];
 
         ++i;
         ++j;
     }
-    cout << endl;
+    stream << endl;
 
     i = lineStartIndex;
     j = 1;
     while (j < pos.column) {
         if (sourceFileContents[i] == 0x9)
-            cout << "    ";
+            stream << "    ";
         else
-            cout << " ";
+            stream << " ";
 
         ++i;
         ++j;
     }
-    cout << Color::BGreen << "^" << Color::BWhite << endl;
+    stream << Color::BGreen << "^" << Color::BWhite << endl;
 
-    cout << Color::Reset << flush;
+    stream << Color::Reset << flush;
 }
 
 string getTokenString(const Token &token) {
@@ -145,6 +155,9 @@ string getTokenString(const Token &token) {
         break;
     case Token::Type::ASSUME_DIRECTIVE:
         returnString = Token::assumeDirectiveStr;
+        break;
+    case Token::Type::PUBLIC_DIRECTIVE:
+        returnString = Token::publicDirectiveStr;
     }
 
     return returnString;
@@ -362,7 +375,7 @@ void printPseudoSentenceTable(const vector<PseudoSentencesSegment> &segmentPseud
             strNameVector.push_back(getTokenString(it->baseTokenContainer.token));
             strSegmentVector.push_back(segIt->segName);
 
-            auto assumeMap = it->assume.getMap();
+            const auto &assumeMap = it->assume.getMap();
             string assumeStr;
             for (auto jt = assumeMap.begin(); jt != assumeMap.end(); ++jt) {
                 if (!assumeStr.empty())
@@ -400,7 +413,7 @@ void printRawSentenceTable(const vector<RawSentencesSegment> &rawSentencesSegmen
     size_t maxOpsAmmount = 0;
     for (auto segIt = rawSentencesSegmentContainerVector.begin(); segIt != rawSentencesSegmentContainerVector.end(); ++segIt) {
         for (auto it = segIt->rawSentences.begin(); it != segIt->rawSentences.end(); ++it) {
-            auto present = (*it)->present(labelMap);
+            auto present = it->present(labelMap);
             const vector<string> &operandStrVector = get<1>(present);
 
             if (operandStrVector.size() > maxOpsAmmount)
@@ -422,14 +435,14 @@ void printRawSentenceTable(const vector<RawSentencesSegment> &rawSentencesSegmen
 
     for (auto segIt = rawSentencesSegmentContainerVector.begin(); segIt != rawSentencesSegmentContainerVector.end(); ++segIt) {
         for (auto it = segIt->rawSentences.begin(); it != segIt->rawSentences.end(); ++it) {
-            auto present = (*it)->present(labelMap);
+            auto present = it->present(labelMap);
             const vector<string> &operandStrVector = get<1>(present);
 
             strIndexVector.push_back(std::to_string(it - segIt->rawSentences.begin()));
             strNameVector.push_back(get<0>(present));
             strSegmentVector.push_back(segIt->segName);
 
-            auto assumeMap = (*it)->assume().getMap();
+            const auto &assumeMap = it->assume().getMap();
             string assumeStr;
             for (auto jt = assumeMap.begin(); jt != assumeMap.end(); ++jt) {
                 if (!assumeStr.empty())
@@ -463,7 +476,7 @@ void printSentenceTable(const vector<SentencesSegment> &sentencesSegmentContaine
     size_t maxOpsAmmount = 0;
     for (auto segIt = sentencesSegmentContainerVector.begin(); segIt != sentencesSegmentContainerVector.end(); ++segIt) {
         for (auto it = segIt->sentences.begin(); it != segIt->sentences.end(); ++it) {
-            auto present = (*it)->present();
+            auto present = it->present();
             const vector<string> &operandStrVector = get<1>(present);
 
             if (operandStrVector.size() > maxOpsAmmount)
@@ -485,14 +498,14 @@ void printSentenceTable(const vector<SentencesSegment> &sentencesSegmentContaine
 
     for (auto segIt = sentencesSegmentContainerVector.begin(); segIt != sentencesSegmentContainerVector.end(); ++segIt) {
         for (auto it = segIt->sentences.begin(); it != segIt->sentences.end(); ++it) {
-            auto present = (*it)->present();
+            auto present = it->present();
             const vector<string> &operandStrVector = get<1>(present);
 
             strIndexVector.push_back(std::to_string(it - segIt->sentences.begin()));
             strNameVector.push_back(get<0>(present));
             strSegmentVector.push_back(segIt->segName);
 
-            auto assumeMap = (*it)->assume.getMap();
+            const auto &assumeMap = it->assume().getMap();
             string assumeStr;
             for (auto jt = assumeMap.begin(); jt != assumeMap.end(); ++jt) {
                 if (!assumeStr.empty())
@@ -521,139 +534,108 @@ void printSentenceTable(const vector<SentencesSegment> &sentencesSegmentContaine
     printTable("Sentence Table", strTableVectors);
 }
 
-string hexStringFromSentenceBytePresentation(const vector<vector<uchar>> &sentenceBytePresentation) {
-    std::stringstream strStream;
-    strStream << std::hex << std::uppercase << std::setfill('0');
-    
-    for (auto it = sentenceBytePresentation.begin(); it != sentenceBytePresentation.end(); ++it) {
-        auto jt = it->end();
-        do {
-            --jt;
-
-            strStream << std::setw(2) << (unsigned int)*jt;
-        } while (jt != it->begin());
-
-        if (it != sentenceBytePresentation.end() - 1)
-            strStream << ' ';
-    }
+void printListing(const vector<SentencesSegment> &sentencesSegmentContainerVector, const vector<EncodedSegment> &encodedSegmentVector) {
+    ListingWriter listingWriter(DiagnosticStreams::out());
+    listingWriter.write(sentencesSegmentContainerVector, encodedSegmentVector);
+    listingWriter.flush();
+}
 
-    return strStream.str();
+void printListing(const vector<SentencesSegment> &sentencesSegmentContainerVector, const vector<EncodedSegment> &encodedSegmentVector, const tuple<vector<PseudoSentencesSegment>, map<string, Label>> &pseudoSentenceSplit) {
+    ListingWriter listingWriter(DiagnosticStreams::out());
+    listingWriter.write(sentencesSegmentContainerVector, encodedSegmentVector, pseudoSentenceSplit);
+    listingWriter.flush();
 }
 
-void printListing(const vector<SentencesSegment> &sentencesSegmentContainerVector) {
-    for (auto segIt = sentencesSegmentContainerVector.begin(); segIt != sentencesSegmentContainerVector.end(); ++segIt) {
-        cout << segIt->segName << " SEGMENT" << endl << endl;
+void printStats(const Stats &stats) {
+    std::ostream &stream = DiagnosticStreams::err();
 
-        size_t disp = 0;
-        cout << std::setfill('0') << std::uppercase;
-        
-        for (auto it = segIt->sentences.begin(); it != segIt->sentences.end(); ++it) {
-            cout << std::hex << std::setw(4) << disp << std::dec << "  ";
-            
-            auto computeRes = (*it)->compute();
-            string sentenceByteCodeStr = hexStringFromSentenceBytePresentation(computeRes);
-            for (size_t i = 0; i < sentenceByteCodeStr.size(); ++i) {
-                cout << sentenceByteCodeStr[i];
-                if (((i % 29) == 0) && (i != 0))
-                    cout << endl << "      ";
-            }
-            printSpace(32 - sentenceByteCodeStr.size() % 30);
-            
-            auto sentencePresent = (*it)->present();
-            cout << get<0>(sentencePresent);
-            printSpace(10 - get<0>(sentencePresent).size());
-            for (auto jt = get<1>(sentencePresent).begin(); jt != get<1>(sentencePresent).end(); ++jt) {
-                if (jt != get<1>(sentencePresent).begin())
-                    cout << ',';
-                cout << *jt;
-            }
+    auto printCounter = [&](const string &name, size_t value) {
+        stream << "  " << std::left << std::setw(40) << name << std::right << std::setw(12) << value << endl;
+    };
 
-            cout << endl;
+    stream << "Instruction matching:" << endl;
+    printCounter("definition lookups", stats.definitionLookups);
+    printCounter("definitions probed", stats.definitionsProbed);
+    printCounter("definition rankings", stats.definitionRankings);
+    printCounter("definitions ranked", stats.definitionsRanked);
 
-            disp += getInstructionBytePresentSize(computeRes);
-        }
+    stream << "Jump relaxation:" << endl;
+    printCounter("passes", stats.relaxationPasses);
+    printCounter("jump size changes", stats.jumpSizeChanges);
 
-        cout << std::hex << std::setw(4) << disp << std::dec << "  " << endl;
+    stream << "Preprocessor:" << endl;
+    printCounter("EQU evaluations", stats.equEvaluations);
+    for (auto it = stats.excludedTokens.begin(); it != stats.excludedTokens.end(); ++it)
+        printCounter("tokens excluded by " + get<0>(*it), get<1>(*it));
 
-        cout << std::setfill(' ');
+    if (!stats.segmentBytes.empty())
+        stream << "Bytes emitted:" << endl;
+    for (auto it = stats.segmentBytes.begin(); it != stats.segmentBytes.end(); ++it)
+        printCounter(get<0>(*it), get<1>(*it));
 
-        cout << endl << segIt->segName << " ENDS" << endl << endl;;
-    }
+    stream.copyfmt(std::ios(nullptr));
 }
 
-void printListing(const vector<SentencesSegment> &sentencesSegmentContainerVector, const tuple<vector<PseudoSentencesSegment>, map<string, Label>> &pseudoSentenceSplit) {
-    const vector<PseudoSentencesSegment> &pseudoSentencesSegmentContainerVector = get<0>(pseudoSentenceSplit);
-    const map<string, Label> &labelMap = get<1>(pseudoSentenceSplit);
-    
-    for (auto segIt = sentencesSegmentContainerVector.begin(); segIt != sentencesSegmentContainerVector.end(); ++segIt) {
-        const vector<PseudoSentence> &pseudoSentenceVector = (pseudoSentencesSegmentContainerVector[segIt - sentencesSegmentContainerVector.begin()]).pseudoSentences;
+void printTimeReport(const PhaseReport &report) {
+    const vector<PhaseReport::Phase> &phases = report.phases();
+    std::ostream &stream = DiagnosticStreams::err();
 
-        cout << segIt->segName << " SEGMENT" << endl << endl;
+    double totalWallTime = 0;
+    double totalCpuTime = 0;
 
-        size_t disp = 0;
-        cout << std::setfill('0') << std::uppercase;
-        
-        for (auto it = segIt->sentences.begin(); it != segIt->sentences.end(); ++it) {
-            for (auto jt = labelMap.begin(); jt != labelMap.end(); ++jt) {
-                if ((segIt->segName == jt->second.segName) && ((size_t)(it - segIt->sentences.begin()) == jt->second.ptr)) {
-                    printSpace(6);
-                    cout << jt->first << ':' << endl;
-                    break;
-                }
-            }
+    stream << std::fixed << std::setprecision(3);
+    stream << std::left << std::setw(16) << "Phase"
+              << std::right << std::setw(12) << "Wall ms"
+              << std::setw(12) << "CPU ms"
+              << std::setw(14) << "Items" << endl;
 
-            const PseudoSentence &pseudoSentence = pseudoSentenceVector[it - segIt->sentences.begin()];
+    for (auto it = phases.begin(); it != phases.end(); ++it) {
+        stream << std::left << std::setw(16) << it->name
+                  << std::right << std::setw(12) << it->wallTime * 1e3
+                  << std::setw(12) << it->cpuTime * 1e3;
 
-            cout << std::hex << std::setw(4) << disp << std::dec << "  ";
-            
-            auto computeRes = (*it)->compute();
-            string sentenceByteCodeStr = hexStringFromSentenceBytePresentation(computeRes);
-            for (size_t i = 0; i < sentenceByteCodeStr.size(); ++i) {
-                cout << sentenceByteCodeStr[i];
-                if (((i % 29) == 0) && (i != 0))
-                    cout << endl << "      ";
-            }
-            printSpace(32 - sentenceByteCodeStr.size() % 30);
-            
-            auto sentencePresent = (*it)->present();
-            cout << get<0>(sentencePresent);
-            printSpace(10 - get<0>(sentencePresent).size());
+        if (it->itemCount)
+            stream << std::setw(14) << *it->itemCount << ' ' << it->itemName;
 
-            for (auto jt = pseudoSentence.operandsTokenContainerVector.begin(); jt != pseudoSentence.operandsTokenContainerVector.end(); ++jt) {
-                bool isPreviousSingleChar = true;
-                for (auto kt = jt->begin(); kt != jt->end(); ++kt) {
-                    string tokenStr = getTokenString(kt->token);
-                    bool isSingleChar = (tokenStr.size() == 1) && (isCharSingleCharacterLexemeCompatible(tokenStr[0]));
+        stream << endl;
 
-                    if ((!isPreviousSingleChar) && (!isSingleChar))
-                        cout << ' ';
+        totalWallTime += it->wallTime;
+        totalCpuTime += it->cpuTime;
+    }
 
-                    cout << tokenStr;
+    stream << std::left << std::setw(16) << "total"
+              << std::right << std::setw(12) << totalWallTime * 1e3
+              << std::setw(12) << totalCpuTime * 1e3 << endl;
 
-                    isPreviousSingleChar = isSingleChar;
-                }
+    stream.copyfmt(std::ios(nullptr));
+}
 
-                if (jt != pseudoSentence.operandsTokenContainerVector.end() - 1)
-                    cout << ',';
-            }
+void printAllocationReport(const PhaseReport &report, std::ostream &stream) {
+    const vector<PhaseReport::Phase> &phases = report.phases();
 
-            cout << endl;
+    size_t totalAllocationCount = 0;
+    size_t totalAllocatedBytes = 0;
+    size_t totalPeakLiveBytes = 0;
 
-            disp += getInstructionBytePresentSize(computeRes);
-        }
+    stream << "{\n";
+    stream << "  \"phases\": [";
 
-        for (auto jt = labelMap.begin(); jt != labelMap.end(); ++jt) {
-            if ((segIt->segName == jt->second.segName) && (segIt->sentences.size() == jt->second.ptr)) {
-                printSpace(6);
-                cout << jt->first << ':' << endl;
-                break;
-            }
-        }
-
-        cout << std::hex << std::setw(4) << disp << std::dec << "  " << endl;
+    for (auto it = phases.begin(); it != phases.end(); ++it) {
+        stream << ((it == phases.begin()) ? "\n" : ",\n");
+        stream << "    {\"name\": \"" << it->name << "\", "
+               << "\"allocations\": " << it->allocationCount << ", "
+               << "\"bytes\": " << it->allocatedBytes << ", "
+               << "\"peakLiveBytes\": " << it->peakLiveBytes << "}";
 
-        cout << std::setfill(' ');
-
-        cout << endl << segIt->segName << " ENDS" << endl << endl;;
+        totalAllocationCount += it->allocationCount;
+        totalAllocatedBytes += it->allocatedBytes;
+        totalPeakLiveBytes = std::max(totalPeakLiveBytes, it->peakLiveBytes);
     }
+
+    stream << "\n  ],\n";
+    stream << "  \"total\": {"
+           << "\"allocations\": " << totalAllocationCount << ", "
+           << "\"bytes\": " << totalAllocatedBytes << ", "
+           << "\"peakLiveBytes\": " << totalPeakLiveBytes << "}\n";
+    stream << "}\n";
 }
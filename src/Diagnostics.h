@@ -8,6 +8,11 @@
 #include "PseudoSentence.h"
 #include "RawSentence.h"
 #include "Sentence.h"
+#include "EncodedSegment.h"
+#include "LineIndex.h"
+#include "ScopedCurrent.h"
+#include "PhaseTimer.h"
+#include "Stats.h"
 
 namespace Color {
 
@@ -31,8 +36,30 @@ constexpr auto BWhite = "\033[1m\033[37m";
 
 }
 
+string getTokenString(const Token &token);
+
+class DiagnosticStreams {
+public:
+    static std::ostream &out();
+    static std::ostream &err();
+
+    class Scope {
+    public:
+        inline Scope(std::ostream &out, std::ostream &err) :
+            outScope(currentOut, &out),
+            errScope(currentErr, &err)
+        {}
+    private:
+        ScopedCurrent<std::ostream *> outScope;
+        ScopedCurrent<std::ostream *> errScope;
+    };
+private:
+    static thread_local std::ostream *currentOut;
+    static thread_local std::ostream *currentErr;
+};
+
 void printError(string text);
-void printCompileError(string text, const string &sourceFileContents, CodePosition pos);
+void printCompileError(string text, const LineIndex &lineIndex, CodePosition pos, bool isReportingOffset = false);
 void printTokenTable(const vector<TokenContainer> &tokenContainerVector);
 void printTokenTable(const vector<TokenContainer> &tokenContainerVector, const vector<LexemeContainer> &lexemeContainerVector);
 void printEquTable(const map<string, Integer> &equMap);
@@ -40,8 +67,12 @@ void printPseudoLabelTable(const map<string, Label> &labelMap);
 void printPseudoSentenceTable(const vector<PseudoSentencesSegment> &segmentPseudoSentenceVector, bool printAssumes = false);
 void printRawSentenceTable(const vector<RawSentencesSegment> &rawSentencesSegmentContainerVector, const map<string, Label> &labelMap, bool printAssumes = false);
 void printSentenceTable(const vector<SentencesSegment> &sentencesSegmentContainerVector, bool printAssumes = false);
-void printListing(const vector<SentencesSegment> &sentencesSegmentContainerVector);
-void printListing(const vector<SentencesSegment> &sentencesSegmentContainerVector, const tuple<vector<PseudoSentencesSegment>, map<string, Label>> &pseudoSentenceSplit);
+void printListing(const vector<SentencesSegment> &sentencesSegmentContainerVector, const vector<EncodedSegment> &encodedSegmentVector);
+void printListing(const vector<SentencesSegment> &sentencesSegmentContainerVector, const vector<EncodedSegment> &encodedSegmentVector, const tuple<vector<PseudoSentencesSegment>, map<string, Label>> &pseudoSentenceSplit);
+
+void printStats(const Stats &stats);
+void printTimeReport(const PhaseReport &report);
+void printAllocationReport(const PhaseReport &report, std::ostream &stream);
 
 template<typename T, typename U>
 typename map<T, U>::const_iterator findByValue(const map<T, U> &source, U value) {
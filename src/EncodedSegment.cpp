@@ -0,0 +1,149 @@
+#include "EncodedSegment.h"
+
+#include "Exception.h"
+#include "Compiler.h"
+#include "Stats.h"
+
+class EncodedChunk {
+public:
+    inline EncodedChunk(size_t segIndex, size_t begin, size_t end) :
+        segIndex(segIndex),
+        begin(begin),
+        end(end),
+        emitter(true),
+        hasInstructions(false)
+    {}
+
+    size_t segIndex;
+    size_t begin;
+    size_t end;
+    ByteEmitter emitter;
+    vector<size_t> sentenceOffsets;
+    vector<size_t> sentenceFields;
+    vector<Relocation> relocations;
+    bool hasInstructions;
+    Stats stats;
+    std::exception_ptr exception;
+};
+
+void encodeChunk(const SentencesSegment &sentencesSegment, EncodedChunk &chunk, bool isRelocatable) {
+    size_t chunkOffset = sentencesSegment.offsets.offset(chunk.begin);
+    vector<Relocation> relocationVector;
+
+    chunk.sentenceOffsets.reserve(chunk.end - chunk.begin);
+    chunk.sentenceFields.reserve(chunk.end - chunk.begin);
+
+    for (size_t index = chunk.begin; index < chunk.end; ++index) {
+        const Sentence &sentence = sentencesSegment.sentences[index];
+
+        relocationVector.clear();
+        sentence.encode(chunk.emitter, &relocationVector);
+
+        if (sentence.is<InstructionSentence>())
+            chunk.hasInstructions = true;
+
+        for (auto it = relocationVector.begin(); it != relocationVector.end(); ++it) {
+            if (it->isRelative && (it->segName == sentencesSegment.segName))
+                continue;
+
+            if (it->isRelative && (!isRelocatable))
+                throw CompileError("relative jump to another segment requires relocatable output", sentence.pos());
+
+            chunk.relocations.push_back(*it);
+        }
+
+        if (chunkOffset + chunk.emitter.size() != sentencesSegment.offsets.offset(index + 1))
+            throw CompileError("encoded size differs from layout", sentence.pos());
+
+        chunk.sentenceOffsets.push_back(chunk.emitter.size());
+        chunk.sentenceFields.push_back(chunk.emitter.fieldCount());
+    }
+}
+
+vector<EncodedSegment> encodeSegments(const vector<SentencesSegment> &sentencesSegmentContainerVector, bool isRelocatable, ThreadPool *threadPool) {
+    bool isParallel = threadPool && (threadPool->threadCount() > 1);
+
+    vector<EncodedChunk> chunkVector;
+    for (size_t segIndex = 0; segIndex < sentencesSegmentContainerVector.size(); ++segIndex) {
+        size_t sentenceCount = sentencesSegmentContainerVector[segIndex].sentences.size();
+        size_t chunkSize = isParallel ? encodeChunkSize : std::max<size_t>(sentenceCount, 1);
+
+        size_t begin = 0;
+        do {
+            size_t end = std::min(begin + chunkSize, sentenceCount);
+            chunkVector.emplace_back(segIndex, begin, end);
+            begin = end;
+        } while (begin < sentenceCount);
+    }
+
+    Stats *stats = Stats::current();
+
+    auto encodeTask = [&](size_t chunkIndex) {
+        EncodedChunk &chunk = chunkVector[chunkIndex];
+        Stats::Scope statsScope(stats ? &chunk.stats : nullptr);
+
+        try {
+            encodeChunk(sentencesSegmentContainerVector[chunk.segIndex], chunk, isRelocatable);
+        } catch (...) {
+            chunk.exception = std::current_exception();
+        }
+    };
+
+    if (isParallel && (chunkVector.size() > 1)) {
+        Compiler::Arch arch = Compiler::arch;
+
+        threadPool->parallelFor(chunkVector.size(), [&](size_t chunkIndex) {
+            Compiler::ArchScope archScope(arch);
+            encodeTask(chunkIndex);
+        });
+    } else {
+        for (size_t chunkIndex = 0; chunkIndex < chunkVector.size(); ++chunkIndex)
+            encodeTask(chunkIndex);
+    }
+
+    for (auto it = chunkVector.begin(); it != chunkVector.end(); ++it) {
+        if (it->exception)
+            std::rethrow_exception(it->exception);
+
+        if (stats)
+            stats->merge(it->stats);
+    }
+
+    vector<EncodedSegment> encodedSegmentVector;
+    encodedSegmentVector.reserve(sentencesSegmentContainerVector.size());
+
+    for (auto it = chunkVector.begin(); it != chunkVector.end(); ++it) {
+        const SentencesSegment &sentencesSegment = sentencesSegmentContainerVector[it->segIndex];
+
+        if (it->begin == 0) {
+            encodedSegmentVector.emplace_back(sentencesSegment.segName);
+            encodedSegmentVector.back().sentenceOffsets.reserve(sentencesSegment.sentences.size() + 1);
+            encodedSegmentVector.back().sentenceFields.reserve(sentencesSegment.sentences.size() + 1);
+        }
+
+        EncodedSegment &encodedSegment = encodedSegmentVector.back();
+        size_t byteBase = encodedSegment.emitter.size();
+        size_t fieldBase = encodedSegment.emitter.fieldCount();
+
+        if (it->begin == 0)
+            encodedSegment.emitter = std::move(it->emitter);
+        else
+            encodedSegment.emitter.append(it->emitter);
+
+        for (auto jt = it->sentenceOffsets.begin(); jt != it->sentenceOffsets.end(); ++jt)
+            encodedSegment.sentenceOffsets.push_back(byteBase + *jt);
+
+        for (auto jt = it->sentenceFields.begin(); jt != it->sentenceFields.end(); ++jt)
+            encodedSegment.sentenceFields.push_back(fieldBase + *jt);
+
+        for (auto jt = it->relocations.begin(); jt != it->relocations.end(); ++jt) {
+            encodedSegment.relocations.push_back(*jt);
+            encodedSegment.relocations.back().offset += byteBase;
+        }
+
+        if (it->hasInstructions)
+            encodedSegment.hasInstructions = true;
+    }
+
+    return encodedSegmentVector;
+}
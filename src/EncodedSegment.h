@@ -0,0 +1,59 @@
+#ifndef _ENCODEDSEGMENT_H_
+#define _ENCODEDSEGMENT_H_
+
+#include "Global.h"
+#include "ByteEmitter.h"
+#include "Sentence.h"
+#include "ThreadPool.h"
+
+constexpr size_t encodeChunkSize = 4096;
+
+class EncodedSegment {
+public:
+    inline EncodedSegment(string segName) :
+        segName(segName),
+        emitter(true),
+        sentenceOffsets(1, 0),
+        sentenceFields(1, 0),
+        hasInstructions(false)
+    {}
+
+    inline size_t sentenceCount() const {
+        return sentenceOffsets.size() - 1;
+    }
+
+    inline size_t offset(size_t index) const {
+        return sentenceOffsets[index];
+    }
+
+    inline size_t size(size_t index) const {
+        return sentenceOffsets[index + 1] - sentenceOffsets[index];
+    }
+
+    inline size_t firstField(size_t index) const {
+        return sentenceFields[index];
+    }
+
+    inline size_t lastField(size_t index) const {
+        return sentenceFields[index + 1];
+    }
+
+    inline const uchar *data() const {
+        return emitter.data();
+    }
+
+    inline size_t size() const {
+        return emitter.size();
+    }
+
+    string segName;
+    ByteEmitter emitter;
+    vector<size_t> sentenceOffsets;
+    vector<size_t> sentenceFields;
+    vector<Relocation> relocations;
+    bool hasInstructions;
+};
+
+vector<EncodedSegment> encodeSegments(const vector<SentencesSegment> &sentencesSegmentContainerVector, bool isRelocatable = false, ThreadPool *threadPool = nullptr);
+
+#endif
@@ -80,26 +80,7 @@ uchar composeBits(bitset<2> one, bitset<3> two, bitset<3> three) {
 }
 
 bitset<3> getBitsetFromMask(const Mask &mask, bool useSecondRange = false) {
-    uchar shift = useSecondRange ? 8 : 0;
-
-    if (mask.match(OPVAL0 << shift))
-        return 0b000;
-    else if (mask.match(OPVAL1 << shift))
-        return 0b001;
-    else if (mask.match(OPVAL2 << shift))
-        return 0b010;
-    else if (mask.match(OPVAL3 << shift))
-        return 0b011;
-    else if (mask.match(OPVAL4 << shift))
-        return 0b100;
-    else if (mask.match(OPVAL5 << shift))
-        return 0b101;
-    else if (mask.match(OPVAL6 << shift))
-        return 0b110;
-    else if (mask.match(OPVAL7 << shift))
-        return 0b111;
-    else
-        return 0b000;
+    return mask.opval(useSecondRange);
 }
 
 bitset<2> getMOD(const InstructionSentence::OperandContainer &operandContainer) {
@@ -175,23 +156,30 @@ const map<InstructionSentence::SegmentPrefix, uchar> prefixMap = {
     {InstructionSentence::SegmentPrefix::GS, 0x65},
 };
 
-vector<vector<uchar>> generateOpcode(const vector<uchar> &opcodeByteVector) {
-    vector<vector<uchar>> res;
+void Encoding::pushValue(size_t operandIndex, const Integer &num, Integer::Size size) {
+    valuePatches.push_back({emitter.size(), operandIndex, size});
+    num.putCharArray(size, emitter.emitField(Integer::getByteCount(size)));
+}
 
-    for (auto it = opcodeByteVector.begin(); it != opcodeByteVector.end(); ++it)
-        res.push_back({*it});
+void Encoding::emit(ByteEmitter &target, const InstructionSentence &instructionSentence) const {
+    size_t base = target.size();
+    target.append(emitter);
 
-    return res;
+    for (auto it = valuePatches.begin(); it != valuePatches.end(); ++it)
+        get<0>(instructionSentence.operandContainerVector[it->operand]).num.putCharArray(it->size, target.data() + base + it->offset);
 }
 
-vector<vector<uchar>> generateSegmentOverridePrefixes(const InstructionSentence &instructionSentence, const InstructionSentence::Operand &op) {
-    vector<vector<uchar>> res;
+void generateOpcode(Encoding &encoding, const vector<uchar> &opcodeByteVector) {
+    for (auto it = opcodeByteVector.begin(); it != opcodeByteVector.end(); ++it)
+        encoding.pushField({*it});
+}
 
+void generateSegmentOverridePrefixes(Encoding &encoding, const InstructionSentence &instructionSentence, const InstructionSentence::Operand &op) {
     if (op.mask.match(MEM)) {
         auto segmentPrefix = instructionSentence.segmentPrefix;
 
         if ((!segmentPrefix) && (op.segName)) {
-            auto assumeMap = instructionSentence.assume.getMap();
+            const auto &assumeMap = instructionSentence.assume.getMap();
             auto assumeSegmentIt = assumeMap.find(*op.segName);
             if (assumeSegmentIt != assumeMap.end())
                 segmentPrefix = getSegmentOverridePrefix(assumeSegmentIt->second);
@@ -221,63 +209,51 @@ vector<vector<uchar>> generateSegmentOverridePrefixes(const InstructionSentence
         }
 
         if (segmentPrefix)
-            res.push_back({prefixMap.find(*segmentPrefix)->second});
+            encoding.pushField({prefixMap.find(*segmentPrefix)->second});
     }
-
-    return res;
 }
 
 constexpr uchar dataSizeOverridePrefix    = 0x66;
 constexpr uchar addressSizeOverridePrefix = 0x67;
 
-vector<vector<uchar>> generateAddressSizeOverridePrefix(const InstructionSentence::Operand &op) {
-    vector<vector<uchar>> res;
-
+void generateAddressSizeOverridePrefix(Encoding &encoding, const InstructionSentence::Operand &op) {
     if ((op.mask.match(MEM)) &&
         (((Compiler::arch == Compiler::Arch::X86_16) &&
           (op.mask.match(MEM_32))) ||
          ((Compiler::arch == Compiler::Arch::X86_32) &&
           (op.mask.match(MEM_16)))))
     {
-        res.push_back({addressSizeOverridePrefix});
+        encoding.pushField({addressSizeOverridePrefix});
     }
-
-    return res;
 }
 
-vector<vector<uchar>> generateDataSizeOverridePrefix(const InstructionSentence::Operand &op) {
-    vector<vector<uchar>> res;
-
+void generateDataSizeOverridePrefix(Encoding &encoding, const InstructionSentence::Operand &op) {
     if (((Compiler::arch == Compiler::Arch::X86_16) &&
          (op.mask.match(S32))) ||
         ((Compiler::arch == Compiler::Arch::X86_32) &&
          (op.mask.match(S16))))
     {
-        res.push_back({dataSizeOverridePrefix});
+        encoding.pushField({dataSizeOverridePrefix});
     }
-
-    return res;
 }
 
-vector<vector<uchar>> generateMODRMAndSIB(const InstructionSentence::OperandContainer &opCont, const bitset<3> &reg) {
-    vector<vector<uchar>> res;
-
+void generateMODRMAndSIB(Encoding &encoding, const InstructionSentence::OperandContainer &opCont, size_t opIndex, const bitset<3> &reg) {
     const InstructionSentence::Operand &op = get<0>(opCont);
 
     if (op.mask.match(MEM_16)) {
         if (op.mask.match(MEM_BASE)) {
             if (op.mask.match(MEM_16_BP) && (op.num == 0) && (!op.isLinkable)) {
-                res.push_back({composeBits(0b01, reg, 0b110)});
-                res.push_back({0});
+                encoding.pushField({composeBits(0b01, reg, 0b110)});
+                encoding.pushField({0});
             } else {
-                res.push_back({composeBits(getMOD(opCont), reg, getBitsetFromMask(op.mask))});
+                encoding.pushField({composeBits(getMOD(opCont), reg, getBitsetFromMask(op.mask))});
                 
                 if ((op.num != 0) || op.isLinkable)
-                    res.push_back(op.num.getCharArraySigned(getSuitableDispSize(op)));
+                    encoding.pushValue(opIndex, op.num, getSuitableDispSize(op));
             }
         } else {
-            res.push_back({composeBits(0b00, reg, 0b110)});
-            res.push_back({op.num.getCharArraySigned(Integer::Size::S_16)});
+            encoding.pushField({composeBits(0b00, reg, 0b110)});
+            encoding.pushValue(opIndex, op.num, Integer::Size::S_16);
         }
     } else if (op.mask.match(MEM_32)) {
         if (op.mask.match(MEM_32_INDEX)) {
@@ -286,131 +262,99 @@ vector<vector<uchar>> generateMODRMAndSIB(const InstructionSentence::OperandCont
 
             if (op.mask.match(MEM_BASE)) {
                 if (op.mask.match(MEM_32_BASE_EBP) && (op.num == 0) && (!op.isLinkable)) {
-                    res.push_back({composeBits(0b01, reg, 0b100)});
-                    res.push_back({composeBits(scale, index, 0b101)});
-                    res.push_back({0});
+                    encoding.pushField({composeBits(0b01, reg, 0b100)});
+                    encoding.pushField({composeBits(scale, index, 0b101)});
+                    encoding.pushField({0});
                 } else {
-                    res.push_back({composeBits(getMOD(opCont), reg, 0b100)});
-                    res.push_back({composeBits(scale, index, getBitsetFromMask(op.mask))});
+                    encoding.pushField({composeBits(getMOD(opCont), reg, 0b100)});
+                    encoding.pushField({composeBits(scale, index, getBitsetFromMask(op.mask))});
 
                     if ((op.num != 0) || op.isLinkable)
-                        res.push_back(op.num.getCharArraySigned(getSuitableDispSize(op)));
+                        encoding.pushValue(opIndex, op.num, getSuitableDispSize(op));
                 }
             } else {
-                res.push_back({composeBits(0b00, reg, 0b100)});
-                res.push_back({composeBits(scale, index, 0b101)});
-                res.push_back({op.num.getCharArraySigned(Integer::Size::S_32)});
+                encoding.pushField({composeBits(0b00, reg, 0b100)});
+                encoding.pushField({composeBits(scale, index, 0b101)});
+                encoding.pushValue(opIndex, op.num, Integer::Size::S_32);
             }
         } else {
             if (op.mask.match(MEM_BASE)) {
                 if (op.mask.match(MEM_32_BASE_EBP) && (op.num == 0) && (!op.isLinkable)) {
-                    res.push_back({composeBits(0b01, reg, 0b101)});
-                    res.push_back({0});
+                    encoding.pushField({composeBits(0b01, reg, 0b101)});
+                    encoding.pushField({0});
                 } else if (op.mask.match(MEM_32_BASE_ESP)) {
-                    res.push_back({composeBits(getMOD(opCont), reg, 0b100)});
-                    res.push_back({composeBits(0b00, 0b100, 0b100)});
+                    encoding.pushField({composeBits(getMOD(opCont), reg, 0b100)});
+                    encoding.pushField({composeBits(0b00, 0b100, 0b100)});
 
                     if ((op.num != 0) || op.isLinkable)
-                        res.push_back({op.num.getCharArraySigned(getSuitableDispSize(op))});
+                        encoding.pushValue(opIndex, op.num, getSuitableDispSize(op));
                 } else {
-                    res.push_back({composeBits(getMOD(opCont), reg, getBitsetFromMask(op.mask))});
+                    encoding.pushField({composeBits(getMOD(opCont), reg, getBitsetFromMask(op.mask))});
                     
                     if ((op.num != 0) || op.isLinkable) 
-                        res.push_back({op.num.getCharArraySigned(getSuitableDispSize(op))});
+                        encoding.pushValue(opIndex, op.num, getSuitableDispSize(op));
                 }
             } else {
-                res.push_back({composeBits(0b00, reg, 0b101)});
-                res.push_back({op.num.getCharArraySigned(Integer::Size::S_32)});
+                encoding.pushField({composeBits(0b00, reg, 0b101)});
+                encoding.pushValue(opIndex, op.num, Integer::Size::S_32);
             }
         }
     } else {
-        res.push_back({composeBits(getMOD(opCont), reg, getBitsetFromMask(op.mask))});
+        encoding.pushField({composeBits(getMOD(opCont), reg, getBitsetFromMask(op.mask))});
     }
-
-    return res;
 }
 
-vector<vector<uchar>> generateMODRMAndSIB(const InstructionSentence::OperandContainer &mainOpCont, const InstructionSentence::OperandContainer &regOpCont) {
-    return generateMODRMAndSIB(mainOpCont, getBitsetFromMask(get<0>(regOpCont).mask));
+void generateMODRMAndSIB(Encoding &encoding, const InstructionSentence::OperandContainer &mainOpCont, size_t mainOpIndex, const InstructionSentence::OperandContainer &regOpCont) {
+    generateMODRMAndSIB(encoding, mainOpCont, mainOpIndex, getBitsetFromMask(get<0>(regOpCont).mask));
 }
 
-vector<vector<uchar>> onlyOpcodeComputeFunc(Definition definition, InstructionSentence) {
-    return generateOpcode(definition.opcode);
+void generateImmediate(Encoding &encoding, const Definition &definition, size_t opIndex, const InstructionSentence::Operand &op) {
+    if (definition.operandFullMasks[opIndex].mask.match(IMM32))
+        encoding.pushValue(opIndex, op.num, Integer::Size::S_32);
+    else if (definition.operandFullMasks[opIndex].mask.match(IMM16))
+        encoding.pushValue(opIndex, op.num, Integer::Size::S_16);
+    else
+        encoding.pushValue(opIndex, op.num, Integer::Size::S_8);
 }
 
-vector<vector<uchar>> twoOpsOpcodeWithREGAndIMMComputeFunc(Definition definition, InstructionSentence instructionSentence) {
-    vector<vector<uchar>> res;
+void onlyOpcodeComputeFunc(const Definition &definition, const InstructionSentence &, Encoding &encoding) {
+    generateOpcode(encoding, definition.opcode);
+}
 
+void twoOpsOpcodeWithREGAndIMMComputeFunc(const Definition &definition, const InstructionSentence &instructionSentence, Encoding &encoding) {
     auto firstOpCont = instructionSentence.operandContainerVector[0];
     auto secondOpCont = instructionSentence.operandContainerVector[1];
 
     auto &firstOp = get<0>(firstOpCont);
     auto &secondOp = get<0>(secondOpCont);
 
-    auto segmentOverridePrefixes = generateSegmentOverridePrefixes(instructionSentence, firstOp);
-    res.insert(res.end(), segmentOverridePrefixes.begin(), segmentOverridePrefixes.end());
-
-    auto dataSizeOverridePrefix = generateDataSizeOverridePrefix(firstOp);
-    res.insert(res.end(), dataSizeOverridePrefix.begin(), dataSizeOverridePrefix.end());
-
-    auto addressSizeOverridePrefix = generateAddressSizeOverridePrefix(firstOp);
-    res.insert(res.end(), addressSizeOverridePrefix.begin(), addressSizeOverridePrefix.end());
-
-    auto opcode = generateOpcode(definition.opcode);
-    res.insert(res.end(), opcode.begin(), opcode.end());
-
-    auto addressMODRMAndSIB = generateMODRMAndSIB(firstOpCont, *definition.opcodeAdd);
-    res.insert(res.end(), addressMODRMAndSIB.begin(), addressMODRMAndSIB.end());
-
-    if (definition.operandFullMasks[1].mask.match(IMM32))
-        res.push_back(secondOp.num.getCharArrayAny(Integer::Size::S_32));
-    else if (definition.operandFullMasks[1].mask.match(IMM16))
-        res.push_back(secondOp.num.getCharArrayAny(Integer::Size::S_16));
-    else
-        res.push_back(secondOp.num.getCharArrayAny(Integer::Size::S_8));
-
-    return res;
+    generateSegmentOverridePrefixes(encoding, instructionSentence, firstOp);
+    generateDataSizeOverridePrefix(encoding, firstOp);
+    generateAddressSizeOverridePrefix(encoding, firstOp);
+    generateOpcode(encoding, definition.opcode);
+    generateMODRMAndSIB(encoding, firstOpCont, 0, *definition.opcodeAdd);
+    generateImmediate(encoding, definition, 1, secondOp);
 }
 
-vector<vector<uchar>> oneOpOpcodeWithREGComputeFunc(Definition definition, InstructionSentence instructionSentence) {
-    vector<vector<uchar>> res;
-
+void oneOpOpcodeWithREGComputeFunc(const Definition &definition, const InstructionSentence &instructionSentence, Encoding &encoding) {
     auto firstOpCont = instructionSentence.operandContainerVector[0];
 
     auto &firstOp = get<0>(firstOpCont);
 
-    auto segmentOverridePrefixes = generateSegmentOverridePrefixes(instructionSentence, firstOp);
-    res.insert(res.end(), segmentOverridePrefixes.begin(), segmentOverridePrefixes.end());
-
-    auto dataSizeOverridePrefix = generateDataSizeOverridePrefix(firstOp);
-    res.insert(res.end(), dataSizeOverridePrefix.begin(), dataSizeOverridePrefix.end());
-
-    auto addressSizeOverridePrefix = generateAddressSizeOverridePrefix(firstOp);
-    res.insert(res.end(), addressSizeOverridePrefix.begin(), addressSizeOverridePrefix.end());
-
-    auto opcode = generateOpcode(definition.opcode);
-    res.insert(res.end(), opcode.begin(), opcode.end());
-
-    auto addressMODRMAndSIB = generateMODRMAndSIB(firstOpCont, *definition.opcodeAdd);
-    res.insert(res.end(), addressMODRMAndSIB.begin(), addressMODRMAndSIB.end());
-
-    return res;
+    generateSegmentOverridePrefixes(encoding, instructionSentence, firstOp);
+    generateDataSizeOverridePrefix(encoding, firstOp);
+    generateAddressSizeOverridePrefix(encoding, firstOp);
+    generateOpcode(encoding, definition.opcode);
+    generateMODRMAndSIB(encoding, firstOpCont, 0, *definition.opcodeAdd);
 }
 
 template<bool orderDirect>
-vector<vector<uchar>> twoOpsClassicComputeFunc(Definition definition, InstructionSentence instructionSentence) {
-    vector<vector<uchar>> res;
+void twoOpsClassicComputeFunc(const Definition &definition, const InstructionSentence &instructionSentence, Encoding &encoding) {
+    size_t mainOpIndex = orderDirect ? 0 : 1;
+    size_t regOpIndex = orderDirect ? 1 : 0;
 
-    InstructionSentence::OperandContainer mainOpCont;
-    InstructionSentence::OperandContainer regOpCont;
-    
-    if (orderDirect) {
-        mainOpCont = instructionSentence.operandContainerVector[0];
-        regOpCont = instructionSentence.operandContainerVector[1];
-    } else {
-        mainOpCont = instructionSentence.operandContainerVector[1];
-        regOpCont = instructionSentence.operandContainerVector[0];
-    }
+    InstructionSentence::OperandContainer mainOpCont = instructionSentence.operandContainerVector[mainOpIndex];
+    InstructionSentence::OperandContainer regOpCont = instructionSentence.operandContainerVector[regOpIndex];
 
     auto &mainOp = get<0>(mainOpCont);
     auto &regOp = get<0>(regOpCont);
@@ -418,149 +362,90 @@ vector<vector<uchar>> twoOpsClassicComputeFunc(Definition definition, Instructio
     if (!mainOp.mask.matchAny(S_ANY))
         mainOp.mask |= regOp.mask & S_ANY;
 
-    auto segmentOverridePrefixes = generateSegmentOverridePrefixes(instructionSentence, mainOp);
-    res.insert(res.end(), segmentOverridePrefixes.begin(), segmentOverridePrefixes.end());
-
-    auto dataSizeOverridePrefix = generateDataSizeOverridePrefix(mainOp);
-    res.insert(res.end(), dataSizeOverridePrefix.begin(), dataSizeOverridePrefix.end());
-
-    auto addressSizeOverridePrefix = generateAddressSizeOverridePrefix(mainOp);
-    res.insert(res.end(), addressSizeOverridePrefix.begin(), addressSizeOverridePrefix.end());
-
-    auto opcode = generateOpcode(definition.opcode);
-    res.insert(res.end(), opcode.begin(), opcode.end());
-
-    auto addressMODRMAndSIB = generateMODRMAndSIB(mainOpCont, regOpCont);
-    res.insert(res.end(), addressMODRMAndSIB.begin(), addressMODRMAndSIB.end());
-
-    return res;
+    generateSegmentOverridePrefixes(encoding, instructionSentence, mainOp);
+    generateDataSizeOverridePrefix(encoding, mainOp);
+    generateAddressSizeOverridePrefix(encoding, mainOp);
+    generateOpcode(encoding, definition.opcode);
+    generateMODRMAndSIB(encoding, mainOpCont, mainOpIndex, regOpCont);
 }
 
-vector<vector<uchar>> twoOpsAXSpecialWithIMMComputeFunc(Definition definition, InstructionSentence instructionSentence) {
-    vector<vector<uchar>> res;
-
+void twoOpsAXSpecialWithIMMComputeFunc(const Definition &definition, const InstructionSentence &instructionSentence, Encoding &encoding) {
     auto firstOpCont = instructionSentence.operandContainerVector[0];
     auto secondOpCont = instructionSentence.operandContainerVector[1];
 
     auto &firstOp = get<0>(firstOpCont);
     auto &secondOp = get<0>(secondOpCont);
 
-    auto dataSizeOverridePrefix = generateDataSizeOverridePrefix(firstOp);
-    res.insert(res.end(), dataSizeOverridePrefix.begin(), dataSizeOverridePrefix.end());
-
-    auto opcode = generateOpcode(definition.opcode);
-    res.insert(res.end(), opcode.begin(), opcode.end());
-
-    if (definition.operandFullMasks[1].mask.match(IMM32))
-        res.push_back(secondOp.num.getCharArrayAny(Integer::Size::S_32));
-    else if (definition.operandFullMasks[1].mask.match(IMM16))
-        res.push_back(secondOp.num.getCharArrayAny(Integer::Size::S_16));
-    else
-        res.push_back(secondOp.num.getCharArrayAny(Integer::Size::S_8));
-
-    return res;
+    generateDataSizeOverridePrefix(encoding, firstOp);
+    generateOpcode(encoding, definition.opcode);
+    generateImmediate(encoding, definition, 1, secondOp);
 }
 
 template<bool orderDirect>
-vector<vector<uchar>> twoOpsMoffsSpecialComputeFunc(Definition definition, InstructionSentence instructionSentence) {
-    vector<vector<uchar>> res;
-
-    InstructionSentence::OperandContainer mainOpCont;
-    InstructionSentence::OperandContainer moffsOpCont;
-    
-    if (orderDirect) {
-        mainOpCont = instructionSentence.operandContainerVector[1];
-        moffsOpCont = instructionSentence.operandContainerVector[0];
-    } else {
-        mainOpCont = instructionSentence.operandContainerVector[0];
-        moffsOpCont = instructionSentence.operandContainerVector[1];
-    }
-
-    auto &mainOp = get<0>(mainOpCont);
-    auto &moffsOp = get<0>(moffsOpCont);
+void twoOpsMoffsSpecialComputeFunc(const Definition &definition, const InstructionSentence &instructionSentence, Encoding &encoding) {
+    size_t mainOpIndex = orderDirect ? 1 : 0;
+    size_t moffsOpIndex = orderDirect ? 0 : 1;
 
-    auto dataSizeOverridePrefix = generateDataSizeOverridePrefix(mainOp);
-    res.insert(res.end(), dataSizeOverridePrefix.begin(), dataSizeOverridePrefix.end());
+    auto &mainOp = get<0>(instructionSentence.operandContainerVector[mainOpIndex]);
+    auto &moffsOp = get<0>(instructionSentence.operandContainerVector[moffsOpIndex]);
 
-    auto opcode = generateOpcode(definition.opcode);
-    res.insert(res.end(), opcode.begin(), opcode.end());
+    generateDataSizeOverridePrefix(encoding, mainOp);
+    generateOpcode(encoding, definition.opcode);
 
     if (Compiler::arch == Compiler::Arch::X86_32)
-        res.push_back(moffsOp.num.getCharArraySigned(Integer::Size::S_32));
+        encoding.pushValue(moffsOpIndex, moffsOp.num, Integer::Size::S_32);
     else
-        res.push_back(moffsOp.num.getCharArraySigned(Integer::Size::S_16));
-    
-    return res;
+        encoding.pushValue(moffsOpIndex, moffsOp.num, Integer::Size::S_16);
 }
 
-vector<vector<uchar>> oneOpOpcodeIncComputeFunc(Definition definition, InstructionSentence instructionSentence) {
-    vector<vector<uchar>> res;
-
+void oneOpOpcodeIncComputeFunc(const Definition &definition, const InstructionSentence &instructionSentence, Encoding &encoding) {
     auto firstOpCont = instructionSentence.operandContainerVector[0];
 
     auto &firstOp = get<0>(firstOpCont);
 
-    auto dataSizeOverridePrefix = generateDataSizeOverridePrefix(firstOp);
-    res.insert(res.end(), dataSizeOverridePrefix.begin(), dataSizeOverridePrefix.end());
+    generateDataSizeOverridePrefix(encoding, firstOp);
 
     uchar opcode = *(definition.opcode.end() - 1);
     opcode += getBitsetFromMask(firstOp.mask).to_ulong();
-    res.push_back({opcode});
-
-    return res;
+    encoding.pushField({opcode});
 }
 
-vector<vector<uchar>> twoOpsOpcodeIncWithImmComputeFunc(Definition definition, InstructionSentence instructionSentence) {
-    vector<vector<uchar>> res;
-
+void twoOpsOpcodeIncWithImmComputeFunc(const Definition &definition, const InstructionSentence &instructionSentence, Encoding &encoding) {
     auto firstOpCont = instructionSentence.operandContainerVector[0];
     auto secondOpCont = instructionSentence.operandContainerVector[1];
 
     auto &firstOp = get<0>(firstOpCont);
     auto &secondOp = get<0>(secondOpCont);
 
-    auto dataSizeOverridePrefix = generateDataSizeOverridePrefix(firstOp);
-    res.insert(res.end(), dataSizeOverridePrefix.begin(), dataSizeOverridePrefix.end());
+    generateDataSizeOverridePrefix(encoding, firstOp);
 
     uchar opcode = *(definition.opcode.end() - 1);
     opcode += getBitsetFromMask(firstOp.mask).to_ulong();
-    res.push_back({opcode});
-
-    if (definition.operandFullMasks[1].mask.match(IMM32))
-        res.push_back(secondOp.num.getCharArrayAny(Integer::Size::S_32));
-    else if (definition.operandFullMasks[1].mask.match(IMM16))
-        res.push_back(secondOp.num.getCharArrayAny(Integer::Size::S_16));
-    else
-        res.push_back(secondOp.num.getCharArrayAny(Integer::Size::S_8));
+    encoding.pushField({opcode});
 
-    return res;
+    generateImmediate(encoding, definition, 1, secondOp);
 }
 
-vector<vector<uchar>> relativeJumpComputeFunc(Definition definition, InstructionSentence instructionSentence) {
-    vector<vector<uchar>> res;
-
+void relativeJumpComputeFunc(const Definition &definition, const InstructionSentence &instructionSentence, Encoding &encoding) {
     auto firstOpCont = instructionSentence.operandContainerVector[0];
 
     auto &firstOp = get<0>(firstOpCont);
 
-    auto opcode = generateOpcode(definition.opcode);
-    res.insert(res.end(), opcode.begin(), opcode.end());
+    generateOpcode(encoding, definition.opcode);
 
     if (definition.operandFullMasks[0].mask.match(REL32)) {
         if (Compiler::arch == Compiler::Arch::X86_32)
-            res.push_back(firstOp.num.getCharArraySigned(Integer::Size::S_32));
+            encoding.pushValue(0, firstOp.num, Integer::Size::S_32);
         else
             throw CompileError("too big relative path", get<1>(firstOpCont));
     } else if (definition.operandFullMasks[0].mask.match(REL16)) {
         if (Compiler::arch == Compiler::Arch::X86_32)
-            res.push_back(firstOp.num.getCharArraySigned(Integer::Size::S_32));
+            encoding.pushValue(0, firstOp.num, Integer::Size::S_32);
         else
-            res.push_back(firstOp.num.getCharArraySigned(Integer::Size::S_16));
+            encoding.pushValue(0, firstOp.num, Integer::Size::S_16);
     }
     else
-        res.push_back(firstOp.num.getCharArraySigned(Integer::Size::S_8));
-
-    return res;
+        encoding.pushValue(0, firstOp.num, Integer::Size::S_8);
 }
 
 const vector<Definition> instructionDefinitionVector = {
@@ -579,16 +464,49 @@ const vector<Definition> instructionDefinitionVector = {
     {{0x88},    Instruction::MOV,   {{MEM8_ANY}, {UREG8_ANY}},                   twoOpsClassicComputeFunc<true>},
     {{0x89},    Instruction::MOV,   {{MEM32_ANY}, {UREG32_ANY}},                 twoOpsClassicComputeFunc<true>},
 
-    {{0x76},    Instruction::JBE,   {{REL8_FILL}},                               relativeJumpComputeFunc}
+    {{0x76},    Instruction::JBE,   {{REL8_FILL}},                               relativeJumpComputeFunc},
+    {{0x0F, 0x86}, Instruction::JBE, {{REL16_FILL}},                             relativeJumpComputeFunc},
+    {{0x0F, 0x86}, Instruction::JBE, {{REL32_FILL}},                             relativeJumpComputeFunc}
 };
 
+map<DefinitionKey, vector<const Definition *>> buildDefinitionIndex() {
+    map<DefinitionKey, vector<const Definition *>> definitionIndex;
+
+    std::function<void(const Definition &, DefinitionKey, size_t)> addDefinition =
+        [&](const Definition &definition, DefinitionKey key, size_t operandIndex) {
+            if (operandIndex == definition.operandFullMasks.size()) {
+                definitionIndex[key].push_back(&definition);
+                return;
+            }
+
+            unsigned long long operandClass = (definition.operandFullMasks[operandIndex].mask & CLASS_ANY).to_ullong();
+
+            for (unsigned long long subClass = operandClass; ; subClass = (subClass - 1) & operandClass) {
+                DefinitionKey subKey = key;
+                subKey.addOperand(subClass);
+                addDefinition(definition, subKey, operandIndex + 1);
+
+                if (subClass == 0)
+                    break;
+            }
+        };
+
+    for (auto it = instructionDefinitionVector.begin(); it != instructionDefinitionVector.end(); ++it)
+        addDefinition(*it, DefinitionKey(it->instruction), 0);
+
+    return definitionIndex;
 }
 
-size_t getInstructionBytePresentSize(const vector<vector<uchar>> &instructionBytePresent) {
-    size_t res = 0;
+const map<DefinitionKey, vector<const Definition *>> definitionIndex = buildDefinitionIndex();
 
-    for (auto it = instructionBytePresent.begin(); it != instructionBytePresent.end(); ++it)
-        res += it->size();
+const vector<const Definition *> &findDefinitionCandidates(const DefinitionKey &key) {
+    static const vector<const Definition *> noCandidates;
+
+    auto it = definitionIndex.find(key);
+    if (it == definitionIndex.end())
+        return noCandidates;
+
+    return it->second;
+}
 
-    return res;
 }
@@ -4,6 +4,7 @@
 #include "Global.h"
 #include "OperandMask.h"
 #include "Integer.h"
+#include "ByteEmitter.h"
 #include <bitset>
 
 namespace OperandMask {
@@ -51,6 +52,30 @@ public:
     optional<Integer> num;
 };
 
+class Encoding {
+public:
+    class ValuePatch {
+    public:
+        size_t offset;
+        size_t operand;
+        Integer::Size size;
+    };
+
+    inline Encoding() :
+        emitter(true)
+    {}
+
+    inline void pushField(std::initializer_list<uchar> field) {
+        emitter.emitField(field);
+    }
+
+    void pushValue(size_t operandIndex, const Integer &num, Integer::Size size);
+    void emit(ByteEmitter &target, const InstructionSentence &instructionSentence) const;
+
+    ByteEmitter emitter;
+    vector<ValuePatch> valuePatches;
+};
+
 class Definition {
 public:
     typedef InstructionNS::Instruction Instruction;
@@ -59,7 +84,7 @@ public:
                       uchar opcodeAdd,
                       Instruction inst,
                       vector<OperandFullMask> operandFullMasks,
-                      function<vector<vector<uchar>>(Definition, InstructionSentence)> computeFunc) :
+                      function<void(const Definition &, const InstructionSentence &, Encoding &)> computeFunc) :
         opcode(opcode),
         opcodeAdd(opcodeAdd),
         instruction(inst),
@@ -70,24 +95,60 @@ public:
     inline Definition(vector<uchar> opcode,
                       Instruction inst,
                       vector<OperandFullMask> operandFullMasks,
-                      function<vector<vector<uchar>>(Definition, InstructionSentence)> computeFunc) :
+                      function<void(const Definition &, const InstructionSentence &, Encoding &)> computeFunc) :
         opcode(opcode),
         instruction(inst),
         operandFullMasks(operandFullMasks),
         computeFunc(computeFunc)
     {}
 
+    inline bool hasFixedOperandValue() const {
+        for (auto it = operandFullMasks.begin(); it != operandFullMasks.end(); ++it) {
+            if (it->num)
+                return true;
+        }
+
+        return false;
+    }
+
     vector<uchar> opcode;
     optional<uchar> opcodeAdd;
     Instruction instruction;
     vector<OperandFullMask> operandFullMasks;
-    function<vector<vector<uchar>>(Definition, InstructionSentence)> computeFunc;
+    function<void(const Definition &, const InstructionSentence &, Encoding &)> computeFunc;
 };
 
 extern const vector<Definition> instructionDefinitionVector;
 
-}
+class DefinitionKey {
+public:
+    inline DefinitionKey(Instruction instruction) :
+        instruction(instruction),
+        operandCount(0),
+        operandClasses(0)
+    {}
+
+    inline void addOperand(OperandMask::Mask mask) {
+        if (operandCount < maxOperandCount)
+            operandClasses |= (mask & OperandMask::CLASS_ANY).to_ullong() << (operandClassBits * operandCount);
+
+        ++operandCount;
+    }
+
+    inline bool operator<(const DefinitionKey &key) const {
+        return std::tie(instruction, operandCount, operandClasses) < std::tie(key.instruction, key.operandCount, key.operandClasses);
+    }
 
-size_t getInstructionBytePresentSize(const vector<vector<uchar>> &instructionBytePresent);
+    static constexpr size_t operandClassBits = 4;
+    static constexpr size_t maxOperandCount = 64 / operandClassBits;
+private:
+    Instruction instruction;
+    size_t operandCount;
+    unsigned long long operandClasses;
+};
+
+const vector<const Definition *> &findDefinitionCandidates(const DefinitionKey &key);
+
+}
 
 #endif
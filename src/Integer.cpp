@@ -319,6 +319,13 @@ vector<uchar> Integer::getCharArrayAny(Size size) const {
     return getCharArrayUnsigned(size);
 }
 
+void Integer::putCharArray(Size size, uchar *dest) const {
+    size_t byteCount = getByteCount(size);
+
+    for (size_t i = 0; i < byteCount; ++i)
+        dest[i] = (uchar)(val >> (i * 8));
+}
+
 Integer Integer::getMaxValSigned(Size size) {
     switch (size) {
     case Size::S_8:
@@ -361,3 +368,16 @@ Integer::Size Integer::nextSize(Size size) {
         return Size::S_64;
     }
 }
+
+size_t Integer::getByteCount(Size size) {
+    switch (size) {
+    case Size::S_8:
+        return 1;
+    case Size::S_16:
+        return 2;
+    case Size::S_32:
+        return 4;
+    default:
+        return 8;
+    }
+}
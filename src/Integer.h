@@ -119,11 +119,13 @@ public:
     std::vector<unsigned char> getCharArraySigned(Size size) const;
     std::vector<unsigned char> getCharArrayUnsigned(Size size) const;
     std::vector<unsigned char> getCharArrayAny(Size size) const;
+    void putCharArray(Size size, unsigned char *dest) const;
 
     static Integer getMaxValSigned(Size size);
     static Integer getMaxValUnsigned(Size size);
     static Integer getMaxValAny(Size size);
     static Size nextSize(Size size);
+    static size_t getByteCount(Size size);
 private:
     UInt val;
     bool isSigned;
@@ -0,0 +1,40 @@
+#include "LineIndex.h"
+
+#include "Lexeme.h"
+
+const vector<size_t> &LineIndex::lineBegins() const {
+    if (lineBeginVector.empty()) {
+        lineBeginVector.push_back(0);
+
+        for (size_t i = 0; i < sourceFileContents.size(); ++i) {
+            if ((sourceFileContents[i] == cCR) && (i + 1 < sourceFileContents.size()) && (sourceFileContents[i + 1] == cLF))
+                ++i;
+
+            if ((sourceFileContents[i] == cCR) || (sourceFileContents[i] == cLF))
+                lineBeginVector.push_back(i + 1);
+        }
+    }
+
+    return lineBeginVector;
+}
+
+size_t LineIndex::lineBegin(size_t row) const {
+    const vector<size_t> &lineBeginVector = lineBegins();
+
+    if ((row == 0) || (row > lineBeginVector.size()))
+        return sourceFileContents.size();
+
+    return lineBeginVector[row - 1];
+}
+
+size_t LineIndex::lineEnd(size_t row) const {
+    size_t i = lineBegin(row);
+    while ((i < sourceFileContents.size()) && (sourceFileContents[i] != cCR) && (sourceFileContents[i] != cLF))
+        ++i;
+
+    return i;
+}
+
+size_t LineIndex::offset(const CodePosition &pos) const {
+    return std::min(lineBegin(pos.row) + pos.column - 1, sourceFileContents.size());
+}
@@ -0,0 +1,27 @@
+#ifndef _LINEINDEX_H_
+#define _LINEINDEX_H_
+
+#include "Global.h"
+#include "CodePosition.h"
+
+class LineIndex {
+public:
+    inline LineIndex(const string &sourceFileContents) :
+        sourceFileContents(sourceFileContents)
+    {}
+
+    size_t lineBegin(size_t row) const;
+    size_t lineEnd(size_t row) const;
+    size_t offset(const CodePosition &pos) const;
+
+    inline const string &contents() const {
+        return sourceFileContents;
+    }
+private:
+    const vector<size_t> &lineBegins() const;
+
+    const string &sourceFileContents;
+    mutable vector<size_t> lineBeginVector;
+};
+
+#endif
@@ -0,0 +1,243 @@
+#include "ListingWriter.h"
+
+#include "Diagnostics.h"
+#include "Lexeme.h"
+#include <array>
+
+namespace {
+
+std::array<char, 512> makeHexTable() {
+    const char digits[] = "0123456789ABCDEF";
+
+    std::array<char, 512> hexTable;
+    for (size_t i = 0; i < 256; ++i) {
+        hexTable[2 * i] = digits[i >> 4];
+        hexTable[2 * i + 1] = digits[i & 0xF];
+    }
+
+    return hexTable;
+}
+
+const std::array<char, 512> hexTable = makeHexTable();
+
+const string &getMnemonic(const Sentence &sentence) {
+    static const map<InstructionNS::Instruction, string> instructionNameMap = [] {
+        map<InstructionNS::Instruction, string> res;
+        for (auto it = InstructionNS::instructionMap.begin(); it != InstructionNS::instructionMap.end(); ++it)
+            res.emplace(it->second, it->first);
+        return res;
+    }();
+
+    static const map<InstructionNS::DataIdentifier, string> dataIdentifierNameMap = [] {
+        map<InstructionNS::DataIdentifier, string> res;
+        for (auto it = InstructionNS::dataIdentifierMap.begin(); it != InstructionNS::dataIdentifierMap.end(); ++it)
+            res.emplace(it->second, it->first);
+        return res;
+    }();
+
+    if (sentence.is<InstructionSentence>())
+        return instructionNameMap.find(sentence.get<InstructionSentence>().instruction)->second;
+    else
+        return dataIdentifierNameMap.find(sentence.get<DataSentence>().dataIdentifier)->second;
+}
+
+vector<vector<const string *>> getLabelNameVectors(const vector<SentencesSegment> &sentencesSegmentContainerVector, const map<string, Label> &labelMap) {
+    map<string, size_t> segIndexMap;
+    vector<vector<const string *>> labelNameVectors;
+    for (auto it = sentencesSegmentContainerVector.begin(); it != sentencesSegmentContainerVector.end(); ++it) {
+        segIndexMap[it->segName] = labelNameVectors.size();
+        labelNameVectors.emplace_back(it->sentences.size() + 1, nullptr);
+    }
+
+    for (auto it = labelMap.begin(); it != labelMap.end(); ++it) {
+        auto segIndexIt = segIndexMap.find(it->second.segName);
+        if (segIndexIt == segIndexMap.end())
+            continue;
+
+        const string *&labelName = labelNameVectors[segIndexIt->second][it->second.ptr];
+        if (!labelName)
+            labelName = &it->first;
+    }
+
+    return labelNameVectors;
+}
+
+}
+
+ListingWriter::ListingWriter(OutputFile &outputFile) :
+    outputFile(&outputFile),
+    stream(nullptr)
+{
+    buffer.reserve(bufferSize + bufferSize / 4);
+}
+
+ListingWriter::ListingWriter(std::ostream &stream) :
+    outputFile(nullptr),
+    stream(&stream)
+{
+    buffer.reserve(bufferSize + bufferSize / 4);
+}
+
+ListingWriter::~ListingWriter() {
+    try {
+        flush();
+    } catch (std::exception &) {
+    }
+}
+
+void ListingWriter::flush() {
+    if (!buffer.empty()) {
+        if (outputFile)
+            outputFile->write(buffer.data(), buffer.size());
+        else
+            stream->write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+}
+
+void ListingWriter::putAddress(size_t address) {
+    size_t digitCount = 4;
+    while ((digitCount < 2 * sizeof(size_t)) && (address >> (4 * digitCount)))
+        ++digitCount;
+
+    for (size_t i = digitCount; i > 0; --i)
+        put(hexTable[2 * ((address >> (4 * (i - 1))) & 0xF) + 1]);
+
+    put(' ');
+    put(' ');
+}
+
+void ListingWriter::putSentenceBytes(const EncodedSegment &encodedSegment, size_t index) {
+    const ByteEmitter &emitter = encodedSegment.emitter;
+    size_t firstField = encodedSegment.firstField(index);
+    size_t lastField = encodedSegment.lastField(index);
+
+    byteStr.clear();
+    for (size_t field = firstField; field < lastField; ++field) {
+        const uchar *begin = emitter.data() + emitter.fieldBegin(field);
+        const uchar *it = emitter.data() + emitter.fieldEnd(field);
+        while (it != begin) {
+            --it;
+
+            byteStr.push_back(hexTable[2 * *it]);
+            byteStr.push_back(hexTable[2 * *it + 1]);
+        }
+
+        if (field != lastField - 1)
+            byteStr.push_back(' ');
+    }
+
+    for (size_t i = 0; i < byteStr.size(); ++i) {
+        put(byteStr[i]);
+        if (((i % 29) == 0) && (i != 0)) {
+            put('\n');
+            putSpaces(6);
+        }
+    }
+    putSpaces(32 - byteStr.size() % 30);
+}
+
+void ListingWriter::putLabel(const string *labelName) {
+    if (labelName) {
+        putSpaces(6);
+        put(*labelName);
+        put(':');
+        put('\n');
+    }
+}
+
+void ListingWriter::putSegmentBegin(const string &segName) {
+    put(segName);
+    put(" SEGMENT\n\n");
+}
+
+void ListingWriter::putSegmentEnd(const EncodedSegment &encodedSegment) {
+    putAddress(encodedSegment.size());
+    put('\n');
+    put('\n');
+    put(encodedSegment.segName);
+    put(" ENDS\n\n");
+    flushIfFull();
+}
+
+void ListingWriter::write(const vector<SentencesSegment> &sentencesSegmentContainerVector, const vector<EncodedSegment> &encodedSegmentVector) {
+    for (auto segIt = sentencesSegmentContainerVector.begin(); segIt != sentencesSegmentContainerVector.end(); ++segIt) {
+        const EncodedSegment &encodedSegment = encodedSegmentVector[segIt - sentencesSegmentContainerVector.begin()];
+
+        putSegmentBegin(segIt->segName);
+
+        for (auto it = segIt->sentences.begin(); it != segIt->sentences.end(); ++it) {
+            size_t index = it - segIt->sentences.begin();
+            putAddress(encodedSegment.offset(index));
+            putSentenceBytes(encodedSegment, index);
+
+            auto sentencePresent = it->present();
+            put(get<0>(sentencePresent));
+            if (get<0>(sentencePresent).size() < 10)
+                putSpaces(10 - get<0>(sentencePresent).size());
+
+            for (auto jt = get<1>(sentencePresent).begin(); jt != get<1>(sentencePresent).end(); ++jt) {
+                if (jt != get<1>(sentencePresent).begin())
+                    put(',');
+                put(*jt);
+            }
+
+            put('\n');
+            flushIfFull();
+        }
+
+        putSegmentEnd(encodedSegment);
+    }
+}
+
+void ListingWriter::write(const vector<SentencesSegment> &sentencesSegmentContainerVector, const vector<EncodedSegment> &encodedSegmentVector, const tuple<vector<PseudoSentencesSegment>, map<string, Label>> &pseudoSentenceSplit) {
+    const vector<PseudoSentencesSegment> &pseudoSentencesSegmentContainerVector = get<0>(pseudoSentenceSplit);
+    vector<vector<const string *>> labelNameVectors = getLabelNameVectors(sentencesSegmentContainerVector, get<1>(pseudoSentenceSplit));
+
+    for (auto segIt = sentencesSegmentContainerVector.begin(); segIt != sentencesSegmentContainerVector.end(); ++segIt) {
+        size_t segIndex = segIt - sentencesSegmentContainerVector.begin();
+        const ArenaVector<PseudoSentence> &pseudoSentenceVector = pseudoSentencesSegmentContainerVector[segIndex].pseudoSentences;
+        const EncodedSegment &encodedSegment = encodedSegmentVector[segIndex];
+        const vector<const string *> &labelNameVector = labelNameVectors[segIndex];
+
+        putSegmentBegin(segIt->segName);
+
+        for (auto it = segIt->sentences.begin(); it != segIt->sentences.end(); ++it) {
+            size_t index = it - segIt->sentences.begin();
+            const PseudoSentence &pseudoSentence = pseudoSentenceVector[index];
+
+            putLabel(labelNameVector[index]);
+            putAddress(encodedSegment.offset(index));
+            putSentenceBytes(encodedSegment, index);
+
+            const string &mnemonic = getMnemonic(*it);
+            put(mnemonic);
+            if (mnemonic.size() < 10)
+                putSpaces(10 - mnemonic.size());
+
+            for (auto jt = pseudoSentence.operandsTokenContainerVector.begin(); jt != pseudoSentence.operandsTokenContainerVector.end(); ++jt) {
+                bool isPreviousSingleChar = true;
+                for (auto kt = jt->begin(); kt != jt->end(); ++kt) {
+                    string tokenStr = getTokenString(kt->token);
+                    bool isSingleChar = (tokenStr.size() == 1) && (isCharSingleCharacterLexemeCompatible(tokenStr[0]));
+
+                    if ((!isPreviousSingleChar) && (!isSingleChar))
+                        put(' ');
+
+                    put(tokenStr);
+
+                    isPreviousSingleChar = isSingleChar;
+                }
+
+                if (jt != pseudoSentence.operandsTokenContainerVector.end() - 1)
+                    put(',');
+            }
+
+            put('\n');
+            flushIfFull();
+        }
+
+        putLabel(labelNameVector[segIt->sentences.size()]);
+        putSegmentEnd(encodedSegment);
+    }
+}
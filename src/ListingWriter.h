@@ -0,0 +1,54 @@
+#ifndef _LISTINGWRITER_H_
+#define _LISTINGWRITER_H_
+
+#include "Global.h"
+#include "PseudoSentence.h"
+#include "Sentence.h"
+#include "EncodedSegment.h"
+#include "OutputFile.h"
+
+class ListingWriter {
+public:
+    ListingWriter(OutputFile &outputFile);
+    ListingWriter(std::ostream &stream);
+    ~ListingWriter();
+
+    void write(const vector<SentencesSegment> &sentencesSegmentContainerVector, const vector<EncodedSegment> &encodedSegmentVector);
+    void write(const vector<SentencesSegment> &sentencesSegmentContainerVector, const vector<EncodedSegment> &encodedSegmentVector, const tuple<vector<PseudoSentencesSegment>, map<string, Label>> &pseudoSentenceSplit);
+    void flush();
+private:
+    ListingWriter(const ListingWriter &) = delete;
+    ListingWriter &operator=(const ListingWriter &) = delete;
+
+    inline void flushIfFull() {
+        if (buffer.size() >= bufferSize)
+            flush();
+    }
+
+    inline void put(char ch) {
+        buffer.push_back(ch);
+    }
+
+    inline void put(const string &str) {
+        buffer.insert(buffer.end(), str.begin(), str.end());
+    }
+
+    inline void putSpaces(size_t count) {
+        buffer.insert(buffer.end(), count, ' ');
+    }
+
+    void putAddress(size_t address);
+    void putSentenceBytes(const EncodedSegment &encodedSegment, size_t index);
+    void putLabel(const string *labelName);
+    void putSegmentBegin(const string &segName);
+    void putSegmentEnd(const EncodedSegment &encodedSegment);
+
+    static constexpr size_t bufferSize = 256 * 1024;
+
+    OutputFile *outputFile;
+    std::ostream *stream;
+    vector<char> buffer;
+    string byteStr;
+};
+
+#endif
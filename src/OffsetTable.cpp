@@ -0,0 +1,34 @@
+#include "OffsetTable.h"
+
+OffsetTable::OffsetTable()
+{}
+
+OffsetTable::OffsetTable(const vector<size_t> &sizeVector) :
+    sizeVector(sizeVector),
+    tree(sizeVector.size() + 1, 0)
+{
+    for (size_t i = 1; i < tree.size(); ++i) {
+        tree[i] += sizeVector[i - 1];
+
+        size_t parent = i + (i & -i);
+        if (parent < tree.size())
+            tree[parent] += tree[i];
+    }
+}
+
+void OffsetTable::setSize(size_t index, size_t size) {
+    size_t oldSize = sizeVector[index];
+    sizeVector[index] = size;
+
+    for (size_t i = index + 1; i < tree.size(); i += i & -i)
+        tree[i] += size - oldSize;
+}
+
+size_t OffsetTable::offset(size_t index) const {
+    size_t res = 0;
+
+    for (size_t i = index; i > 0; i -= i & -i)
+        res += tree[i];
+
+    return res;
+}
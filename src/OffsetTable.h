@@ -0,0 +1,30 @@
+#ifndef _OFFSETTABLE_H_
+#define _OFFSETTABLE_H_
+
+#include "Global.h"
+
+class OffsetTable {
+public:
+    OffsetTable();
+    OffsetTable(const vector<size_t> &sizeVector);
+
+    void setSize(size_t index, size_t size);
+    size_t offset(size_t index) const;
+
+    inline size_t size(size_t index) const {
+        return sizeVector[index];
+    }
+
+    inline size_t count() const {
+        return sizeVector.size();
+    }
+
+    inline size_t total() const {
+        return offset(count());
+    }
+private:
+    vector<size_t> sizeVector;
+    vector<size_t> tree;
+};
+
+#endif
@@ -11,6 +11,7 @@ enum : unsigned long long {
     MEM                     = 1ull << 1,
     IMM                     = 1ull << 2,
     REL                     = 1ull << 3,
+    CLASS_ANY               = UREG | MEM | IMM | REL,
 
     S8                      = 1ull << 16,
     S16                     = 1ull << 17,
@@ -154,129 +155,149 @@ enum : unsigned long long {
     REL32_FILL              = REL16_FILL | REL32
 };
 
-class Mask : public bitset<64> {
+class Mask {
 public:
     constexpr Mask() noexcept :
-        bitset<64>(0)
+        value(0)
     {}
 
     constexpr Mask(unsigned long long val) noexcept :
-        bitset<64>(val)
+        value(val)
     {}
 
-    constexpr Mask(const bitset<64> &bitSet) :
-        bitset<64>(bitSet)
-    {}
+    constexpr unsigned long long to_ullong() const noexcept {
+        return value;
+    }
+
+    constexpr bool any() const noexcept {
+        return value != 0;
+    }
+
+    constexpr bool none() const noexcept {
+        return value == 0;
+    }
+
+    constexpr size_t count() const noexcept {
+        return __builtin_popcountll(value);
+    }
+
+    constexpr Mask &reset() noexcept {
+        value = 0;
 
-    inline Mask &operator&=(const Mask &mask) noexcept {
-        bitset<64>::operator&=(mask);
+        return *this;
+    }
+
+    constexpr Mask &operator&=(Mask mask) noexcept {
+        value &= mask.value;
 
         return *this;
     }
 
-    inline Mask &operator|=(const Mask &mask) noexcept {
-        bitset<64>::operator|=(mask);
+    constexpr Mask &operator|=(Mask mask) noexcept {
+        value |= mask.value;
 
         return *this;
     }
 
-    inline Mask &operator^=(const Mask &mask) noexcept {
-        bitset<64>::operator^=(mask);
+    constexpr Mask &operator^=(Mask mask) noexcept {
+        value ^= mask.value;
 
         return *this;
     }
 
-    inline Mask &operator<<=(size_t pos) noexcept {
-        bitset<64>::operator<<=(pos);
+    constexpr Mask &operator<<=(size_t pos) noexcept {
+        value <<= pos;
 
         return *this;
     }
 
-    inline Mask &operator>>=(size_t pos) noexcept {
-        bitset<64>::operator>>=(pos);
+    constexpr Mask &operator>>=(size_t pos) noexcept {
+        value >>= pos;
 
         return *this;
     }
 
-    inline Mask operator~() const noexcept {
-        return bitset<64>::operator~();
+    constexpr Mask operator~() const noexcept {
+        return ~value;
+    }
+
+    constexpr Mask operator<<(size_t pos) const noexcept {
+        return value << pos;
     }
 
-    inline Mask operator<<(size_t pos) const noexcept {
-        return bitset<64>::operator<<(pos);
+    constexpr Mask operator>>(size_t pos) const noexcept {
+        return value >> pos;
     }
 
-    inline Mask operator>>(size_t pos) const noexcept {
-        return bitset<64>::operator>>(pos);
+    constexpr bool operator==(Mask mask) const noexcept {
+        return value == mask.value;
     }
 
-    inline bool operator==(const Mask &mask) const noexcept {
-        return bitset<64>::operator==(mask);
+    constexpr bool operator!=(Mask mask) const noexcept {
+        return value != mask.value;
     }
 
-    inline bool operator!=(const Mask &mask) const noexcept {
-        return bitset<64>::operator!=(mask);
+    constexpr bool operator<(Mask mask) const noexcept {
+        return value < mask.value;
     }
 
-    inline bool operator<(const Mask &mask) const noexcept {
-        return bitset<64>::to_ullong() < mask.to_ullong();
+    constexpr bool operator<=(Mask mask) const noexcept {
+        return value <= mask.value;
     }
 
-    inline bool operator<=(const Mask &mask) const noexcept {
-        return bitset<64>::to_ullong() <= mask.to_ullong();
+    constexpr bool operator>(Mask mask) const noexcept {
+        return value > mask.value;
     }
 
-    inline bool operator>(const Mask &mask) const noexcept {
-        return bitset<64>::to_ullong() > mask.to_ullong();
+    constexpr bool operator>=(Mask mask) const noexcept {
+        return value >= mask.value;
     }
 
-    inline bool operator>=(const Mask &mask) const noexcept {
-        return bitset<64>::to_ullong() >= mask.to_ullong();
+    constexpr bool match(Mask mask) const noexcept {
+        return (value & mask.value) == mask.value;
     }
 
-    inline bool match(Mask mask) const {
-        return !((*this & mask) ^ mask).any();
+    constexpr bool matchAny(Mask mask) const noexcept {
+        return (value & mask.value) != 0;
     }
 
-    inline bool matchAny(Mask mask) const {
-        return (*this & mask).any();
+    constexpr Mask size() const noexcept {
+        return value & S_ANY;
     }
 
-    static inline Mask operandSizeFromIntegerSize(Integer::Size size) {
-        switch (size) {
-        case Integer::Size::S_8:
-            return S8;
-        case Integer::Size::S_16:
-            return S16;
-        case Integer::Size::S_32:
-            return S32;
-        default:
-            return S64;
-        }
+    constexpr uchar opval(bool useSecondRange = false) const noexcept {
+        return opvalFromByte((value >> (useSecondRange ? 56 : 48)) & 0xFF);
     }
 
-    static inline Integer::Size integerSizeFromOperandSize(Mask mask) {
-        if (mask.match(S8))
-            return Integer::Size::S_8;
-        else if (mask.match(S16))
-            return Integer::Size::S_16;
-        else if (mask.match(S32))
-            return Integer::Size::S_32;
-        else
-            return Integer::Size::S_64;
+    static constexpr Mask operandSizeFromIntegerSize(Integer::Size size) noexcept {
+        return (size == Integer::Size::S_8) ? S8 :
+               (size == Integer::Size::S_16) ? S16 :
+               (size == Integer::Size::S_32) ? S32 : S64;
     }
+
+    static constexpr Integer::Size integerSizeFromOperandSize(Mask mask) noexcept {
+        return mask.match(S8) ? Integer::Size::S_8 :
+               mask.match(S16) ? Integer::Size::S_16 :
+               mask.match(S32) ? Integer::Size::S_32 : Integer::Size::S_64;
+    }
+private:
+    static constexpr uchar opvalFromByte(unsigned long long byte) noexcept {
+        return (byte == 0) ? 0 : __builtin_ctzll(byte);
+    }
+
+    unsigned long long value;
 };
 
-inline Mask operator&(const Mask &mask1, const Mask &mask2) {
-    return bitset<64>(mask1) & bitset<64>(mask2);
+constexpr Mask operator&(Mask mask1, Mask mask2) noexcept {
+    return mask1.to_ullong() & mask2.to_ullong();
 }
 
-inline Mask operator|(const Mask &mask1, const Mask &mask2) {
-    return bitset<64>(mask1) | bitset<64>(mask2);
+constexpr Mask operator|(Mask mask1, Mask mask2) noexcept {
+    return mask1.to_ullong() | mask2.to_ullong();
 }
 
-inline Mask operator^(const Mask &mask1, const Mask &mask2) {
-    return bitset<64>(mask1) ^ bitset<64>(mask2);
+constexpr Mask operator^(Mask mask1, Mask mask2) noexcept {
+    return mask1.to_ullong() ^ mask2.to_ullong();
 }
 
 }
@@ -0,0 +1,71 @@
+#include "OutputFile.h"
+
+#include "Exception.h"
+#include <cerrno>
+#include <cstring>
+#include <climits>
+#include <fcntl.h>
+#include <unistd.h>
+
+OutputFile::OutputFile(const string &outputFilePath) :
+    outputFilePath(outputFilePath),
+    fd(open(outputFilePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)),
+    isOwned(true)
+{
+    if (fd < 0)
+        throwError();
+}
+
+OutputFile::OutputFile(int fd, const string &outputFilePath) :
+    outputFilePath(outputFilePath),
+    fd(fd),
+    isOwned(false)
+{}
+
+OutputFile::~OutputFile() {
+    if (isOwned && (fd >= 0))
+        ::close(fd);
+}
+
+void OutputFile::write(vector<iovec> ioVector) {
+    auto it = ioVector.begin();
+    while (it != ioVector.end()) {
+        ssize_t count = writev(fd, &*it, std::min<size_t>(ioVector.end() - it, IOV_MAX));
+        if (count < 0) {
+            if (errno == EINTR)
+                continue;
+
+            throwError();
+        }
+
+        size_t written = count;
+        while ((it != ioVector.end()) && (written >= it->iov_len)) {
+            written -= it->iov_len;
+            ++it;
+        }
+
+        if (written != 0) {
+            it->iov_base = static_cast<uchar *>(it->iov_base) + written;
+            it->iov_len -= written;
+        }
+    }
+}
+
+void OutputFile::write(const void *data, size_t size) {
+    write({{const_cast<void *>(data), size}});
+}
+
+void OutputFile::close() {
+    if (!isOwned)
+        return;
+
+    int result = ::close(fd);
+    fd = -1;
+
+    if (result != 0)
+        throwError();
+}
+
+void OutputFile::throwError() const {
+    throw Exception(string("Unable to write \'") + outputFilePath + "\': " + strerror(errno));
+}
@@ -0,0 +1,27 @@
+#ifndef _OUTPUTFILE_H_
+#define _OUTPUTFILE_H_
+
+#include "Global.h"
+#include <sys/uio.h>
+
+class OutputFile {
+public:
+    OutputFile(const string &outputFilePath);
+    OutputFile(int fd, const string &outputFilePath);
+    ~OutputFile();
+
+    void write(vector<iovec> ioVector);
+    void write(const void *data, size_t size);
+    void close();
+private:
+    OutputFile(const OutputFile &) = delete;
+    OutputFile &operator=(const OutputFile &) = delete;
+
+    void throwError() const;
+
+    const string outputFilePath;
+    int fd;
+    bool isOwned;
+};
+
+#endif
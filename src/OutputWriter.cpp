@@ -0,0 +1,636 @@
+#include "OutputWriter.h"
+
+#include "Exception.h"
+#include "Compiler.h"
+#include "OutputFile.h"
+
+namespace {
+
+class LittleEndianBuffer {
+public:
+    inline LittleEndianBuffer(size_t size) :
+        bytes(size, 0),
+        pos(0)
+    {}
+
+    inline void put(uint32_t value, size_t size) {
+        for (size_t i = 0; i < size; ++i)
+            bytes[pos++] = static_cast<uchar>(value >> (8 * i));
+    }
+
+    inline void put(const string &str) {
+        std::copy(str.begin(), str.end(), bytes.begin() + pos);
+        pos += str.size() + 1;
+    }
+
+    inline void align(size_t alignment) {
+        pos = (pos + alignment - 1) / alignment * alignment;
+    }
+
+    inline size_t size() const {
+        return pos;
+    }
+
+    inline iovec ioVec() {
+        return {bytes.data(), pos};
+    }
+private:
+    vector<uchar> bytes;
+    size_t pos;
+};
+
+class OmfRecordWriter {
+public:
+    inline OmfRecordWriter(OutputFile &outputFile) :
+        outputFile(outputFile)
+    {
+        buffer.reserve(bufferSize);
+    }
+
+    inline void beginRecord(uchar type) {
+        if (buffer.size() + maxRecordSize > bufferSize)
+            flush();
+
+        recordBegin = buffer.size();
+        buffer.push_back(type);
+        buffer.push_back(0);
+        buffer.push_back(0);
+    }
+
+    inline void put(uint32_t value, size_t size) {
+        for (size_t i = 0; i < size; ++i)
+            buffer.push_back(static_cast<uchar>(value >> (8 * i)));
+    }
+
+    inline void putBytes(const uchar *data, size_t size) {
+        buffer.insert(buffer.end(), data, data + size);
+    }
+
+    inline void putName(const string &name) {
+        put(name.size(), 1);
+        putBytes(reinterpret_cast<const uchar *>(name.data()), name.size());
+    }
+
+    inline void putIndex(size_t index) {
+        if (index < 0x80)
+            put(index, 1);
+        else {
+            put(0x80 | (index >> 8), 1);
+            put(index & 0xFF, 1);
+        }
+    }
+
+    inline uchar *recordData() {
+        return buffer.data() + recordBegin + 3;
+    }
+
+    inline size_t recordSize() const {
+        return buffer.size() - recordBegin - 3;
+    }
+
+    inline void endRecord() {
+        size_t length = recordSize() + 1;
+        buffer[recordBegin + 1] = static_cast<uchar>(length);
+        buffer[recordBegin + 2] = static_cast<uchar>(length >> 8);
+
+        uchar checksum = 0;
+        for (size_t i = recordBegin; i < buffer.size(); ++i)
+            checksum += buffer[i];
+        buffer.push_back(static_cast<uchar>(-checksum));
+    }
+
+    inline void flush() {
+        if (!buffer.empty()) {
+            outputFile.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+
+    static constexpr size_t maxRecordSize = 1024;
+private:
+    static constexpr size_t bufferSize = 64 * 1024;
+
+    OutputFile &outputFile;
+    vector<uchar> buffer;
+    size_t recordBegin;
+};
+
+void addInPlace(uchar *data, Integer::Size size, uint32_t addend) {
+    size_t byteCount = Integer::getByteCount(size);
+
+    uint32_t value = 0;
+    for (size_t i = 0; i < byteCount; ++i)
+        value |= uint32_t(data[i]) << (8 * i);
+
+    value += addend;
+    for (size_t i = 0; i < byteCount; ++i)
+        data[i] = static_cast<uchar>(value >> (8 * i));
+}
+
+inline size_t alignOffset(size_t offset, size_t alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+uint32_t getElfRelocationType(const Relocation &relocation) {
+    switch (relocation.size) {
+    case Integer::Size::S_8:
+        return relocation.isRelative ? 23 : 22;
+    case Integer::Size::S_16:
+        return relocation.isRelative ? 21 : 20;
+    case Integer::Size::S_32:
+        return relocation.isRelative ? 2 : 1;
+    default:
+        throw Exception("Relocation size is not supported by ELF32");
+    }
+}
+
+}
+
+void writeFlatBinary(const vector<EncodedSegment> &encodedSegmentVector, const string &outputFilePath) {
+    vector<iovec> ioVector;
+    for (auto it = encodedSegmentVector.begin(); it != encodedSegmentVector.end(); ++it) {
+        if (it->size() != 0)
+            ioVector.push_back({const_cast<uchar *>(it->data()), it->size()});
+    }
+
+    OutputFile outputFile(outputFilePath);
+    outputFile.write(std::move(ioVector));
+    outputFile.close();
+}
+
+void writeElfObject(const vector<EncodedSegment> &encodedSegmentVector, const map<string, Label> &labelMap, const map<string, CodePosition> &publicLabelMap, const string &outputFilePath) {
+    constexpr size_t elfHeaderSize = 52;
+    constexpr size_t sectionHeaderSize = 40;
+    constexpr size_t symbolSize = 16;
+    constexpr size_t relocationSize = 8;
+    constexpr size_t segmentAlignment = 16;
+    constexpr uint32_t sectionTypeProgBits = 1;
+    constexpr uint32_t sectionTypeSymTab = 2;
+    constexpr uint32_t sectionTypeStrTab = 3;
+    constexpr uint32_t sectionTypeRel = 9;
+    constexpr uint32_t sectionFlagWrite = 0x1;
+    constexpr uint32_t sectionFlagAlloc = 0x2;
+    constexpr uint32_t sectionFlagExecInstr = 0x4;
+    constexpr uint32_t sectionFlagInfoLink = 0x40;
+    constexpr uint32_t symbolInfoSection = 0x03;
+    constexpr uint32_t symbolInfoLocal = 0x00;
+    constexpr uint32_t symbolInfoGlobal = 0x10;
+    static const uchar padding[segmentAlignment] = {};
+
+    size_t segmentCount = encodedSegmentVector.size();
+    map<string, size_t> segIndexMap;
+    for (size_t i = 0; i < segmentCount; ++i)
+        segIndexMap[encodedSegmentVector[i].segName] = i;
+
+    size_t relocationSectionCount = 0;
+    size_t relocationCount = 0;
+    size_t shstrtabSize = 1 + string(".symtab").size() + 1 + string(".strtab").size() + 1 + string(".shstrtab").size() + 1;
+    for (auto it = encodedSegmentVector.begin(); it != encodedSegmentVector.end(); ++it) {
+        shstrtabSize += string(".rel").size() + it->segName.size() + 1;
+
+        if (!it->relocations.empty()) {
+            ++relocationSectionCount;
+            relocationCount += it->relocations.size();
+        }
+    }
+
+    vector<map<string, Label>::const_iterator> symbolLabelVector;
+    symbolLabelVector.reserve(labelMap.size());
+    for (auto it = labelMap.begin(); it != labelMap.end(); ++it) {
+        if (publicLabelMap.find(it->first) == publicLabelMap.end())
+            symbolLabelVector.push_back(it);
+    }
+    size_t localLabelCount = symbolLabelVector.size();
+    for (auto it = labelMap.begin(); it != labelMap.end(); ++it) {
+        if (publicLabelMap.find(it->first) != publicLabelMap.end())
+            symbolLabelVector.push_back(it);
+    }
+
+    size_t strtabSize = 1;
+    for (auto it = labelMap.begin(); it != labelMap.end(); ++it)
+        strtabSize += it->first.size() + 1;
+
+    size_t symbolCount = 1 + segmentCount + labelMap.size();
+    size_t symtabSectionIndex = 1 + segmentCount + relocationSectionCount;
+    size_t sectionCount = symtabSectionIndex + 3;
+
+    vector<size_t> segmentOffsetVector(segmentCount);
+    size_t offset = elfHeaderSize;
+    for (size_t i = 0; i < segmentCount; ++i) {
+        offset = alignOffset(offset, segmentAlignment);
+        segmentOffsetVector[i] = offset;
+        offset += encodedSegmentVector[i].size();
+    }
+
+    size_t tailOffset = alignOffset(offset, 4);
+    size_t relocationOffset = tailOffset;
+    size_t symtabOffset = relocationOffset + relocationCount * relocationSize;
+    size_t strtabOffset = symtabOffset + symbolCount * symbolSize;
+    size_t shstrtabOffset = strtabOffset + strtabSize;
+    size_t sectionHeaderOffset = alignOffset(shstrtabOffset + shstrtabSize, 4);
+
+    LittleEndianBuffer header(elfHeaderSize);
+    header.put(0x464C457F, 4);
+    header.put(1, 1);
+    header.put(1, 1);
+    header.put(1, 1);
+    header.align(16);
+    header.put(1, 2);
+    header.put(3, 2);
+    header.put(1, 4);
+    header.put(0, 4);
+    header.put(0, 4);
+    header.put(sectionHeaderOffset, 4);
+    header.put(0, 4);
+    header.put(elfHeaderSize, 2);
+    header.put(0, 2);
+    header.put(0, 2);
+    header.put(sectionHeaderSize, 2);
+    header.put(sectionCount, 2);
+    header.put(sectionCount - 1, 2);
+
+    LittleEndianBuffer tail(sectionHeaderOffset - tailOffset + sectionCount * sectionHeaderSize);
+    vector<uchar> patchedFieldVector;
+
+    for (size_t i = 0; i < segmentCount; ++i) {
+        const EncodedSegment &encodedSegment = encodedSegmentVector[i];
+
+        for (auto it = encodedSegment.relocations.begin(); it != encodedSegment.relocations.end(); ++it) {
+            tail.put(it->offset, 4);
+            tail.put(((1 + segIndexMap.find(it->segName)->second) << 8) | getElfRelocationType(*it), 4);
+
+            if (it->isRelative) {
+                size_t byteCount = Integer::getByteCount(it->size);
+                patchedFieldVector.insert(patchedFieldVector.end(), encodedSegment.data() + it->offset, encodedSegment.data() + it->offset + byteCount);
+                addInPlace(patchedFieldVector.data() + patchedFieldVector.size() - byteCount, it->size, it->offset);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < symbolSize / 4; ++i)
+        tail.put(0, 4);
+    for (size_t i = 0; i < segmentCount; ++i) {
+        tail.put(0, 4);
+        tail.put(0, 4);
+        tail.put(0, 4);
+        tail.put(symbolInfoSection, 1);
+        tail.put(0, 1);
+        tail.put(1 + i, 2);
+    }
+
+    size_t nameOffset = 1;
+    for (size_t i = 0; i < symbolLabelVector.size(); ++i) {
+        auto it = symbolLabelVector[i];
+        size_t segIndex = segIndexMap.find(it->second.segName)->second;
+
+        tail.put(nameOffset, 4);
+        tail.put(encodedSegmentVector[segIndex].offset(it->second.ptr), 4);
+        tail.put(0, 4);
+        tail.put((i < localLabelCount) ? symbolInfoLocal : symbolInfoGlobal, 1);
+        tail.put(0, 1);
+        tail.put(1 + segIndex, 2);
+
+        nameOffset += it->first.size() + 1;
+    }
+
+    tail.put("");
+    for (auto it = symbolLabelVector.begin(); it != symbolLabelVector.end(); ++it)
+        tail.put((*it)->first);
+
+    vector<size_t> segmentNameVector(segmentCount);
+    tail.put("");
+    for (size_t i = 0; i < segmentCount; ++i) {
+        segmentNameVector[i] = tail.size() - shstrtabOffset + tailOffset + string(".rel").size();
+        tail.put(".rel" + encodedSegmentVector[i].segName);
+    }
+    size_t symtabName = tail.size() - shstrtabOffset + tailOffset;
+    tail.put(".symtab");
+    size_t strtabName = tail.size() - shstrtabOffset + tailOffset;
+    tail.put(".strtab");
+    size_t shstrtabName = tail.size() - shstrtabOffset + tailOffset;
+    tail.put(".shstrtab");
+    tail.align(4);
+
+    auto putSectionHeader = [&](size_t name, uint32_t type, uint32_t flags, size_t sectionOffset, size_t size, size_t link, size_t info, size_t alignment, size_t entrySize) {
+        tail.put(name, 4);
+        tail.put(type, 4);
+        tail.put(flags, 4);
+        tail.put(0, 4);
+        tail.put(sectionOffset, 4);
+        tail.put(size, 4);
+        tail.put(link, 4);
+        tail.put(info, 4);
+        tail.put(alignment, 4);
+        tail.put(entrySize, 4);
+    };
+
+    putSectionHeader(0, 0, 0, 0, 0, 0, 0, 0, 0);
+    for (size_t i = 0; i < segmentCount; ++i) {
+        uint32_t flags = sectionFlagAlloc | (encodedSegmentVector[i].hasInstructions ? sectionFlagExecInstr : sectionFlagWrite);
+        putSectionHeader(segmentNameVector[i], sectionTypeProgBits, flags, segmentOffsetVector[i], encodedSegmentVector[i].size(), 0, 0, segmentAlignment, 0);
+    }
+
+    size_t sectionRelocationOffset = relocationOffset;
+    for (size_t i = 0; i < segmentCount; ++i) {
+        const vector<Relocation> &relocationVector = encodedSegmentVector[i].relocations;
+
+        if (!relocationVector.empty()) {
+            putSectionHeader(segmentNameVector[i] - string(".rel").size(), sectionTypeRel, sectionFlagInfoLink, sectionRelocationOffset, relocationVector.size() * relocationSize, symtabSectionIndex, 1 + i, 4, relocationSize);
+            sectionRelocationOffset += relocationVector.size() * relocationSize;
+        }
+    }
+
+    putSectionHeader(symtabName, sectionTypeSymTab, 0, symtabOffset, symbolCount * symbolSize, symtabSectionIndex + 1, 1 + segmentCount + localLabelCount, 4, symbolSize);
+    putSectionHeader(strtabName, sectionTypeStrTab, 0, strtabOffset, strtabSize, 0, 0, 1, 0);
+    putSectionHeader(shstrtabName, sectionTypeStrTab, 0, shstrtabOffset, shstrtabSize, 0, 0, 1, 0);
+
+    vector<iovec> ioVector;
+    ioVector.push_back(header.ioVec());
+
+    offset = elfHeaderSize;
+    size_t patchedFieldOffset = 0;
+    for (size_t i = 0; i < segmentCount; ++i) {
+        const EncodedSegment &encodedSegment = encodedSegmentVector[i];
+
+        if (segmentOffsetVector[i] != offset)
+            ioVector.push_back({const_cast<uchar *>(padding), segmentOffsetVector[i] - offset});
+
+        size_t segmentOffset = 0;
+        for (auto it = encodedSegment.relocations.begin(); it != encodedSegment.relocations.end(); ++it) {
+            if (!it->isRelative)
+                continue;
+
+            size_t byteCount = Integer::getByteCount(it->size);
+            if (it->offset != segmentOffset)
+                ioVector.push_back({const_cast<uchar *>(encodedSegment.data() + segmentOffset), it->offset - segmentOffset});
+            ioVector.push_back({patchedFieldVector.data() + patchedFieldOffset, byteCount});
+
+            patchedFieldOffset += byteCount;
+            segmentOffset = it->offset + byteCount;
+        }
+
+        if (encodedSegment.size() != segmentOffset)
+            ioVector.push_back({const_cast<uchar *>(encodedSegment.data() + segmentOffset), encodedSegment.size() - segmentOffset});
+
+        offset = segmentOffsetVector[i] + encodedSegment.size();
+    }
+
+    if (tailOffset != offset)
+        ioVector.push_back({const_cast<uchar *>(padding), tailOffset - offset});
+    ioVector.push_back(tail.ioVec());
+
+    OutputFile outputFile(outputFilePath);
+    outputFile.write(std::move(ioVector));
+    outputFile.close();
+}
+
+void writeOmfObject(const vector<EncodedSegment> &encodedSegmentVector, const map<string, Label> &labelMap, const map<string, CodePosition> &publicLabelMap, const optional<string> &entryLabel, const string &outputFilePath) {
+    constexpr size_t chunkSize = 1000;
+
+    bool isUse32 = (Compiler::arch == Compiler::Arch::X86_32);
+    size_t offsetSize = isUse32 ? 4 : 2;
+    uchar recordTypeBit = isUse32 ? 1 : 0;
+
+    map<string, size_t> segIndexMap;
+    for (size_t i = 0; i < encodedSegmentVector.size(); ++i) {
+        segIndexMap[encodedSegmentVector[i].segName] = i;
+
+        if ((!isUse32) && (encodedSegmentVector[i].size() > 0x10000))
+            throw Exception(string("Segment \'") + encodedSegmentVector[i].segName + "\' exceeds 64K");
+    }
+
+    string moduleName = outputFilePath.substr(outputFilePath.find_last_of('/') + 1);
+    moduleName = moduleName.substr(0, std::min<size_t>(moduleName.find_last_of('.'), 255));
+
+    OutputFile outputFile(outputFilePath);
+    OmfRecordWriter writer(outputFile);
+
+    writer.beginRecord(0x80);
+    writer.putName(moduleName);
+    writer.endRecord();
+
+    writer.beginRecord(0x96);
+    writer.putName("");
+    for (auto it = encodedSegmentVector.begin(); it != encodedSegmentVector.end(); ++it) {
+        if (writer.recordSize() + it->segName.size() + 1 > OmfRecordWriter::maxRecordSize) {
+            writer.endRecord();
+            writer.beginRecord(0x96);
+        }
+
+        writer.putName(it->segName);
+    }
+    writer.endRecord();
+
+    for (size_t i = 0; i < encodedSegmentVector.size(); ++i) {
+        size_t size = encodedSegmentVector[i].size();
+        bool isBig = (!isUse32) && (size == 0x10000);
+
+        writer.beginRecord(0x98 | recordTypeBit);
+        writer.put(0x68 | (isBig ? 0x02 : 0x00) | (isUse32 ? 0x01 : 0x00), 1);
+        writer.put(isBig ? 0 : size, offsetSize);
+        writer.putIndex(2 + i);
+        writer.putIndex(1);
+        writer.putIndex(1);
+        writer.endRecord();
+    }
+
+    auto putPublicNames = [&](size_t segIndex, uchar recordType, bool isPublic) {
+        bool isRecordOpen = false;
+
+        for (auto it = labelMap.begin(); it != labelMap.end(); ++it) {
+            if ((it->second.segName != encodedSegmentVector[segIndex].segName) || ((publicLabelMap.find(it->first) != publicLabelMap.end()) != isPublic))
+                continue;
+
+            if (isRecordOpen && (writer.recordSize() + it->first.size() + offsetSize + 2 > OmfRecordWriter::maxRecordSize)) {
+                writer.endRecord();
+                isRecordOpen = false;
+            }
+
+            if (!isRecordOpen) {
+                writer.beginRecord(recordType | recordTypeBit);
+                writer.putIndex(0);
+                writer.putIndex(1 + segIndex);
+                isRecordOpen = true;
+            }
+
+            writer.putName(it->first);
+            writer.put(encodedSegmentVector[segIndex].offset(it->second.ptr), offsetSize);
+            writer.putIndex(0);
+        }
+
+        if (isRecordOpen)
+            writer.endRecord();
+    };
+
+    for (size_t i = 0; i < encodedSegmentVector.size(); ++i) {
+        putPublicNames(i, 0xB6, false);
+        putPublicNames(i, 0x90, true);
+    }
+
+    for (size_t i = 0; i < encodedSegmentVector.size(); ++i) {
+        const EncodedSegment &encodedSegment = encodedSegmentVector[i];
+        const vector<Relocation> &relocationVector = encodedSegment.relocations;
+        auto relocationIt = relocationVector.begin();
+
+        size_t offset = 0;
+        while (offset < encodedSegment.size()) {
+            size_t end = std::min(offset + chunkSize, encodedSegment.size());
+
+            auto chunkRelocationIt = relocationIt;
+            while ((chunkRelocationIt != relocationVector.end()) && (chunkRelocationIt->offset < end)) {
+                size_t relocationEnd = chunkRelocationIt->offset + Integer::getByteCount(chunkRelocationIt->size);
+                if (relocationEnd > end) {
+                    end = chunkRelocationIt->offset;
+                    break;
+                }
+
+                ++chunkRelocationIt;
+            }
+
+            writer.beginRecord(0xA0 | recordTypeBit);
+            writer.putIndex(1 + i);
+            writer.put(offset, offsetSize);
+            size_t dataBegin = writer.recordSize();
+            writer.putBytes(encodedSegment.data() + offset, end - offset);
+
+            for (auto it = relocationIt; it != chunkRelocationIt; ++it) {
+                if (it->isRelative)
+                    addInPlace(writer.recordData() + dataBegin + (it->offset - offset), it->size, it->offset + Integer::getByteCount(it->size));
+            }
+            writer.endRecord();
+
+            if (relocationIt != chunkRelocationIt) {
+                writer.beginRecord(0x9C | recordTypeBit);
+
+                for (; relocationIt != chunkRelocationIt; ++relocationIt) {
+                    uint32_t location;
+                    switch (relocationIt->size) {
+                    case Integer::Size::S_8:
+                        location = 0;
+                        break;
+                    case Integer::Size::S_16:
+                        location = 1;
+                        break;
+                    case Integer::Size::S_32:
+                        location = 9;
+                        break;
+                    default:
+                        throw Exception("Relocation size is not supported by OMF");
+                    }
+
+                    size_t recordOffset = relocationIt->offset - offset;
+                    writer.put(0x80 | (relocationIt->isRelative ? 0x00 : 0x40) | (location << 2) | (recordOffset >> 8), 1);
+                    writer.put(recordOffset & 0xFF, 1);
+                    writer.put(0x54, 1);
+                    writer.putIndex(1 + segIndexMap.find(relocationIt->segName)->second);
+                }
+
+                writer.endRecord();
+            }
+
+            offset = end;
+        }
+    }
+
+    writer.beginRecord(0x8A | recordTypeBit);
+    if (entryLabel) {
+        auto labelIt = labelMap.find(*entryLabel);
+        if (labelIt == labelMap.end())
+            throw Exception(string("Entry point \'") + *entryLabel + "\' is not defined");
+
+        size_t segIndex = segIndexMap.find(labelIt->second.segName)->second;
+
+        writer.put(0xC1, 1);
+        writer.put(0x00, 1);
+        writer.putIndex(1 + segIndex);
+        writer.putIndex(1 + segIndex);
+        writer.put(encodedSegmentVector[segIndex].offset(labelIt->second.ptr), offsetSize);
+    } else
+        writer.put(0x00, 1);
+    writer.endRecord();
+
+    writer.flush();
+    outputFile.close();
+}
+
+void writeMzExecutable(const vector<EncodedSegment> &encodedSegmentVector, const map<string, Label> &labelMap, const optional<string> &entryLabel, const string &outputFilePath) {
+    constexpr size_t headerSize = 32;
+    constexpr size_t paragraphSize = 16;
+    constexpr size_t stackSize = 0x1000;
+    static const uchar padding[paragraphSize] = {};
+
+    if (Compiler::arch != Compiler::Arch::X86_16)
+        throw Exception("MZ executable requires the 16-bit architecture");
+
+    map<string, size_t> segIndexMap;
+    vector<size_t> segmentOffsetVector;
+    size_t imageSize = 0;
+    for (size_t i = 0; i < encodedSegmentVector.size(); ++i) {
+        const EncodedSegment &encodedSegment = encodedSegmentVector[i];
+
+        if (encodedSegment.size() > 0x10000)
+            throw Exception(string("Segment \'") + encodedSegment.segName + "\' exceeds 64K");
+
+        for (auto it = encodedSegment.relocations.begin(); it != encodedSegment.relocations.end(); ++it) {
+            if (it->isRelative)
+                throw Exception(string("Segment \'") + encodedSegment.segName + "\' contains a near jump to segment \'" + it->segName + "\'");
+        }
+
+        segIndexMap[encodedSegment.segName] = i;
+        imageSize = alignOffset(imageSize, paragraphSize);
+        segmentOffsetVector.push_back(imageSize);
+        imageSize += encodedSegment.size();
+    }
+
+    size_t entrySegment = 0;
+    size_t entryOffset = 0;
+    if (entryLabel) {
+        auto labelIt = labelMap.find(*entryLabel);
+        if (labelIt == labelMap.end())
+            throw Exception(string("Entry point \'") + *entryLabel + "\' is not defined");
+
+        size_t segIndex = segIndexMap.find(labelIt->second.segName)->second;
+        entrySegment = segmentOffsetVector[segIndex] / paragraphSize;
+        entryOffset = encodedSegmentVector[segIndex].offset(labelIt->second.ptr);
+    }
+
+    size_t fileSize = headerSize + imageSize;
+    size_t stackSegment = alignOffset(imageSize, paragraphSize) / paragraphSize;
+    if ((fileSize > 0xFFFF * 512) || (stackSegment > 0xFFFF))
+        throw Exception("MZ executable exceeds the maximum image size");
+
+    LittleEndianBuffer header(headerSize);
+    header.put(0x5A4D, 2);
+    header.put(fileSize % 512, 2);
+    header.put((fileSize + 511) / 512, 2);
+    header.put(0, 2);
+    header.put(headerSize / paragraphSize, 2);
+    header.put(stackSize / paragraphSize, 2);
+    header.put(0xFFFF, 2);
+    header.put(stackSegment, 2);
+    header.put(stackSize, 2);
+    header.put(0, 2);
+    header.put(entryOffset, 2);
+    header.put(entrySegment, 2);
+    header.put(0x1C, 2);
+    header.put(0, 2);
+    header.align(paragraphSize);
+
+    vector<iovec> ioVector;
+    ioVector.push_back(header.ioVec());
+
+    size_t offset = 0;
+    for (size_t i = 0; i < encodedSegmentVector.size(); ++i) {
+        if (segmentOffsetVector[i] != offset)
+            ioVector.push_back({const_cast<uchar *>(padding), segmentOffsetVector[i] - offset});
+
+        if (encodedSegmentVector[i].size() != 0)
+            ioVector.push_back({const_cast<uchar *>(encodedSegmentVector[i].data()), encodedSegmentVector[i].size()});
+
+        offset = segmentOffsetVector[i] + encodedSegmentVector[i].size();
+    }
+
+    OutputFile outputFile(outputFilePath);
+    outputFile.write(std::move(ioVector));
+    outputFile.close();
+}
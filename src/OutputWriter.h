@@ -0,0 +1,13 @@
+#ifndef _OUTPUTWRITER_H_
+#define _OUTPUTWRITER_H_
+
+#include "Global.h"
+#include "EncodedSegment.h"
+#include "PseudoSentence.h"
+
+void writeFlatBinary(const vector<EncodedSegment> &encodedSegmentVector, const string &outputFilePath);
+void writeElfObject(const vector<EncodedSegment> &encodedSegmentVector, const map<string, Label> &labelMap, const map<string, CodePosition> &publicLabelMap, const string &outputFilePath);
+void writeOmfObject(const vector<EncodedSegment> &encodedSegmentVector, const map<string, Label> &labelMap, const map<string, CodePosition> &publicLabelMap, const optional<string> &entryLabel, const string &outputFilePath);
+void writeMzExecutable(const vector<EncodedSegment> &encodedSegmentVector, const map<string, Label> &labelMap, const optional<string> &entryLabel, const string &outputFilePath);
+
+#endif
@@ -0,0 +1,109 @@
+#ifndef _PHASETIMER_H_
+#define _PHASETIMER_H_
+
+#include "Global.h"
+#include "AllocStats.h"
+#include "Trace.h"
+#include <chrono>
+#include <ctime>
+
+class PhaseReport {
+public:
+    class Phase {
+    public:
+        string name;
+        double wallTime;
+        double cpuTime;
+        optional<size_t> itemCount;
+        string itemName;
+        size_t allocationCount;
+        size_t allocatedBytes;
+        size_t peakLiveBytes;
+    };
+
+    inline PhaseReport(bool isEnabled = false, clockid_t cpuClock = CLOCK_THREAD_CPUTIME_ID) :
+        _isEnabled(isEnabled),
+        _cpuClock(cpuClock)
+    {}
+
+    inline bool isEnabled() const {
+        return _isEnabled;
+    }
+
+    inline double cpuTime() const {
+        timespec time;
+        clock_gettime(_cpuClock, &time);
+
+        return time.tv_sec + time.tv_nsec * 1e-9;
+    }
+
+    inline void addPhase(const char *name, double wallTime, double cpuTime, const AllocStats &allocStats) {
+        _phases.push_back({name, wallTime, cpuTime, nullopt, string(),
+                           allocStats.allocationCount, allocStats.allocatedBytes, allocStats.peakLiveBytes});
+    }
+
+    inline void setItemCount(size_t itemCount, const char *itemName) {
+        if (_isEnabled && (!_phases.empty())) {
+            _phases.back().itemCount = itemCount;
+            _phases.back().itemName = itemName;
+        }
+    }
+
+    inline const vector<Phase> &phases() const {
+        return _phases;
+    }
+
+    template<typename F>
+    auto measure(const char *name, F &&func) -> decltype(func());
+private:
+    bool _isEnabled;
+    clockid_t _cpuClock;
+    vector<Phase> _phases;
+};
+
+class PhaseTimer {
+public:
+    inline PhaseTimer(PhaseReport &report, const char *name) :
+        report(report),
+        name(name),
+        span(name, "phase")
+    {
+        if (report.isEnabled()) {
+            AllocStats::resetPeak();
+            allocStart = AllocStats::snapshot();
+            wallStart = std::chrono::steady_clock::now();
+            cpuStart = report.cpuTime();
+        }
+    }
+
+    inline ~PhaseTimer() {
+        if (report.isEnabled()) {
+            double wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+            double cpuTime = report.cpuTime() - cpuStart;
+
+            AllocStats allocEnd = AllocStats::snapshot();
+            allocEnd.allocationCount -= allocStart.allocationCount;
+            allocEnd.allocatedBytes -= allocStart.allocatedBytes;
+
+            report.addPhase(name, wallTime, cpuTime, allocEnd);
+        }
+    }
+private:
+    PhaseTimer(const PhaseTimer &) = delete;
+    PhaseTimer &operator=(const PhaseTimer &) = delete;
+
+    PhaseReport &report;
+    const char *name;
+    TraceSpan span;
+    std::chrono::steady_clock::time_point wallStart;
+    double cpuStart;
+    AllocStats allocStart;
+};
+
+template<typename F>
+inline auto PhaseReport::measure(const char *name, F &&func) -> decltype(func()) {
+    PhaseTimer timer(*this, name);
+    return func();
+}
+
+#endif
@@ -1,6 +1,8 @@
 #include "Preprocessor.h"
 
 #include "Exception.h"
+#include "Trace.h"
+#include "Stats.h"
 #include "Integer.h"
 #include "Math.h"
 #include <algorithm>
@@ -61,37 +63,25 @@ Integer computeMath(const vector<TokenContainer> &tokenContainerVector, const ma
 }
 
 auto excludeUsedTokens(const vector<TokenContainer> &base, const vector<TokenContainer> &excludes) {
-    vector<TokenContainer> newBase = base;
+    auto posLess = [](const CodePosition &pos1, const CodePosition &pos2) -> bool {
+        return std::tie(pos1.row, pos1.column, pos1.length) < std::tie(pos2.row, pos2.column, pos2.length);
+    };
 
-    for (auto it = excludes.begin(); it != excludes.end(); ++it) {
-        auto elem = std::find(newBase.begin(), newBase.end(), *it);
-        if (elem != newBase.end())
-            newBase.erase(elem);
-    }
+    vector<CodePosition> excludePosVector;
+    excludePosVector.reserve(excludes.size());
+    for (auto it = excludes.begin(); it != excludes.end(); ++it)
+        excludePosVector.push_back(it->pos);
 
-    return newBase;
-}
+    std::sort(excludePosVector.begin(), excludePosVector.end(), posLess);
 
-vector<TokenContainer>::const_iterator getMathTokenSequence(vector<TokenContainer>::const_iterator begin, vector<TokenContainer>::const_iterator end) {
-    auto requireRightParam = [](const Token &token) -> bool {
-        return (token.type() == Token::Type::MATH_SYMBOL) &&
-               (token.value<Token::MathSymbol>() != Token::MathSymbol::BRACKET_CLOSE);
-    };
-    
-    auto it = begin;
-    while ((it != end) &&
-           ((it->token.type() == Token::Type::MATH_SYMBOL) ||
-            ((it->token.type() == Token::Type::USER_IDENTIFIER) &&
-             ((it == begin) ||
-              (requireRightParam((it - 1)->token)))) ||
-            ((it->token.type() == Token::Type::CONSTANT_NUMBER) &&
-             ((it == begin) ||
-              (requireRightParam((it - 1)->token))))))
-    {
-        ++it;
+    vector<TokenContainer> newBase;
+    newBase.reserve(base.size());
+    for (auto it = base.begin(); it != base.end(); ++it) {
+        if (!std::binary_search(excludePosVector.begin(), excludePosVector.end(), it->pos, posLess))
+            newBase.push_back(*it);
     }
 
-    return it;
+    return newBase;
 }
 
 auto processEQUs(const vector<TokenContainer> &tokenContainerVector) {
@@ -151,6 +141,10 @@ auto processEQUs(const vector<TokenContainer> &tokenContainerVector) {
             }
 
             equMap[equName] = computeMath(equMapUnprocessed[equName], equMap);
+
+            Stats *stats = Stats::current();
+            if (stats)
+                ++stats->equEvaluations;
         }
     };
 
@@ -319,6 +313,36 @@ auto processMacros(const vector<TokenContainer> &tokenContainerVector) {
     return tokenContainerVector;
 }
 
+auto processPublics(const vector<TokenContainer> &tokenContainerVector) {
+    map<string, CodePosition> publicLabelMap;
+    vector<TokenContainer> remains;
+    remains.reserve(tokenContainerVector.size());
+
+    for (auto it = tokenContainerVector.begin(); it != tokenContainerVector.end(); ++it) {
+        if (it->token.type() != Token::Type::PUBLIC_DIRECTIVE) {
+            remains.push_back(*it);
+            continue;
+        }
+
+        auto nameIt = it + 1;
+        while (true) {
+            if ((nameIt == tokenContainerVector.end()) || (nameIt->token.type() != Token::Type::USER_IDENTIFIER))
+                throw CompileError("PUBLIC requires a label name", ((nameIt == tokenContainerVector.end()) ? it : nameIt)->pos);
+
+            publicLabelMap.insert({nameIt->token.value<string>(), nameIt->pos});
+
+            if ((nameIt + 1 == tokenContainerVector.end()) || ((nameIt + 1)->token.type() != Token::Type::COMMA))
+                break;
+
+            nameIt += 2;
+        }
+
+        it = nameIt;
+    }
+
+    return make_tuple(remains, publicLabelMap);
+}
+
 auto processSegmentsParting(const vector<TokenContainer> &tokenContainerVector) {
     vector<TokenSegment> segmentTokenContainerVector;
 
@@ -355,24 +379,48 @@ auto processSegmentsParting(const vector<TokenContainer> &tokenContainerVector)
     }
 
     vector<TokenContainer> remains = excludeUsedTokens(tokenContainerVector, excludes);
+    optional<string> entryLabel;
 
     if ((remains.end() - 1)->token.type() == Token::Type::END_DIRECTIVE)
         remains.erase(remains.end() - 1);
     else if (((remains.end() - 1)->token.type() == Token::Type::USER_IDENTIFIER) &&
              ((remains.end() - 2)->token.type() == Token::Type::END_DIRECTIVE))
+    {
+        entryLabel = (remains.end() - 1)->token.value<string>();
         remains.erase(remains.end() - 2, remains.end());
+    }
 
     if (!remains.empty())
         throw CompileError("undefined expression outside segment", remains.begin()->pos);
 
-    return segmentTokenContainerVector;
+    return make_tuple(segmentTokenContainerVector, entryLabel);
 }
 
-tuple<vector<TokenSegment>, map<string, Integer>> preprocess(const vector<TokenContainer> &tokenContainerVector) {
-    auto equPhaseResult = processEQUs(tokenContainerVector);
-    auto ifPhaseResult = processIFs(get<1>(equPhaseResult), get<0>(equPhaseResult));
-    auto constantReplaceResult = processSymbolicConstantReplace(ifPhaseResult, get<0>(equPhaseResult));
-    auto macrosResult = processMacros(constantReplaceResult);
-    auto segmentsPartingResult = processSegmentsParting(macrosResult);
-    return make_tuple(segmentsPartingResult, get<0>(equPhaseResult));
+tuple<vector<TokenSegment>, map<string, Integer>, optional<string>, map<string, CodePosition>> preprocess(const vector<TokenContainer> &tokenContainerVector) {
+    auto traced = [](const char *name, auto &&func) {
+        TraceSpan span(name, "preprocess");
+        return func();
+    };
+
+    auto equPhaseResult = traced("EQU", [&] { return processEQUs(tokenContainerVector); });
+    auto ifPhaseResult = traced("IF", [&] { return processIFs(get<1>(equPhaseResult), get<0>(equPhaseResult)); });
+    auto constantReplaceResult = traced("constant replace", [&] { return processSymbolicConstantReplace(ifPhaseResult, get<0>(equPhaseResult)); });
+    auto macrosResult = traced("macros", [&] { return processMacros(constantReplaceResult); });
+    auto publicsResult = traced("PUBLIC", [&] { return processPublics(macrosResult); });
+    auto segmentsPartingResult = traced("segments", [&] { return processSegmentsParting(get<0>(publicsResult)); });
+
+    Stats *stats = Stats::current();
+    if (stats) {
+        size_t segmentTokenCount = 0;
+        for (auto it = get<0>(segmentsPartingResult).begin(); it != get<0>(segmentsPartingResult).end(); ++it)
+            segmentTokenCount += it->tokenContainers.size();
+
+        stats->excludedTokens.push_back(make_tuple("EQU", tokenContainerVector.size() - get<1>(equPhaseResult).size()));
+        stats->excludedTokens.push_back(make_tuple("IF", get<1>(equPhaseResult).size() - ifPhaseResult.size()));
+        stats->excludedTokens.push_back(make_tuple("constant replace", ifPhaseResult.size() - constantReplaceResult.size()));
+        stats->excludedTokens.push_back(make_tuple("macros", constantReplaceResult.size() - macrosResult.size()));
+        stats->excludedTokens.push_back(make_tuple("PUBLIC", macrosResult.size() - get<0>(publicsResult).size()));
+        stats->excludedTokens.push_back(make_tuple("segments", get<0>(publicsResult).size() - segmentTokenCount));
+    }
+    return make_tuple(get<0>(segmentsPartingResult), get<0>(equPhaseResult), get<1>(segmentsPartingResult), get<1>(publicsResult));
 }
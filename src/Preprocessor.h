@@ -10,7 +10,29 @@ struct TokenSegment {
     vector<TokenContainer> tokenContainers;
 };
 
-vector<TokenContainer>::const_iterator getMathTokenSequence(vector<TokenContainer>::const_iterator begin, vector<TokenContainer>::const_iterator end);
-tuple<vector<TokenSegment>, map<string, Integer>> preprocess(const vector<TokenContainer> &tokenContainerVector);
+template<typename T>
+T getMathTokenSequence(T begin, T end) {
+    auto requireRightParam = [](const Token &token) -> bool {
+        return (token.type() == Token::Type::MATH_SYMBOL) &&
+               (token.value<Token::MathSymbol>() != Token::MathSymbol::BRACKET_CLOSE);
+    };
+    
+    auto it = begin;
+    while ((it != end) &&
+           ((it->token.type() == Token::Type::MATH_SYMBOL) ||
+            ((it->token.type() == Token::Type::USER_IDENTIFIER) &&
+             ((it == begin) ||
+              (requireRightParam((it - 1)->token)))) ||
+            ((it->token.type() == Token::Type::CONSTANT_NUMBER) &&
+             ((it == begin) ||
+              (requireRightParam((it - 1)->token))))))
+    {
+        ++it;
+    }
+
+    return it;
+}
+
+tuple<vector<TokenSegment>, map<string, Integer>, optional<string>, map<string, CodePosition>> preprocess(const vector<TokenContainer> &tokenContainerVector);
 
 #endif
@@ -100,7 +100,7 @@ tuple<vector<PseudoSentencesSegment>, map<string, Label>> splitPseudoSentences(c
     map<string, Label> labelMap;
 
     for (auto segIt = segmentTokenContainerVector.begin(); segIt != segmentTokenContainerVector.end(); ++segIt) {
-        vector<PseudoSentence> pseudoSentenceVector;
+        ArenaVector<PseudoSentence> pseudoSentenceVector;
 
         Assume currentAssume;
 
@@ -141,7 +141,7 @@ tuple<vector<PseudoSentencesSegment>, map<string, Label>> splitPseudoSentences(c
 
                 auto operandEndIt = locateOperand(it, endIt);
                 if (operandEndIt != it) {
-                    pseudoSentence.operandsTokenContainerVector.push_back(vector<TokenContainer>(it, operandEndIt));
+                    pseudoSentence.operandsTokenContainerVector.push_back(ArenaVector<TokenContainer>(it, operandEndIt));
                     it = operandEndIt;
 
                     while ((it != endIt) && (it->token.type() == Token::Type::COMMA)) {
@@ -150,7 +150,7 @@ tuple<vector<PseudoSentencesSegment>, map<string, Label>> splitPseudoSentences(c
                             throw CompileError("no operand after comma", (it - 1)->pos);
 
                         auto operandEndIt = locateOperand(it, endIt);
-                        pseudoSentence.operandsTokenContainerVector.push_back(vector<TokenContainer>(it, operandEndIt));
+                        pseudoSentence.operandsTokenContainerVector.push_back(ArenaVector<TokenContainer>(it, operandEndIt));
                         it = operandEndIt;
                     }
                 }
@@ -214,3 +214,10 @@ tuple<vector<PseudoSentencesSegment>, map<string, Label>> splitPseudoSentences(c
 
     return make_tuple(segmentPseudoSentenceVector, labelMap);
 }
+
+void checkPublicLabels(const map<string, CodePosition> &publicLabelMap, const map<string, Label> &labelMap) {
+    for (auto &publicLabel : publicLabelMap) {
+        if (labelMap.find(publicLabel.first) == labelMap.end())
+            throw CompileError("PUBLIC name is not a label", publicLabel.second);
+    }
+}
@@ -7,29 +7,32 @@
 #include "Math.h"
 #include "Instruction.h"
 #include "OperandMask.h"
+#include "Arena.h"
 
 class Assume {
 public:
+    typedef std::map<string, OperandMask::Mask, std::less<string>, ArenaAllocator<pair<const string, OperandMask::Mask>>> AssumeMap;
+
     inline void setSegment(string segName, OperandMask::Mask segReg) {
         assumeMap[segName] = segReg;
     }
     
-    inline map<string, OperandMask::Mask> getMap() const {
+    inline const AssumeMap &getMap() const {
         return assumeMap;
     }
 private:
-    map<string, OperandMask::Mask> assumeMap;
+    AssumeMap assumeMap;
 };
 
 struct PseudoSentence {
     TokenContainer baseTokenContainer;
-    vector<vector<TokenContainer>> operandsTokenContainerVector;
+    ArenaVector<ArenaVector<TokenContainer>> operandsTokenContainerVector;
     Assume assume;
 };
 
 struct PseudoSentencesSegment {
     string segName;
-    vector<PseudoSentence> pseudoSentences;
+    ArenaVector<PseudoSentence> pseudoSentences;
 };
 
 class Label {
@@ -59,5 +62,6 @@ public:
 };
 
 tuple<vector<PseudoSentencesSegment>, map<string, Label>> splitPseudoSentences(const vector<TokenSegment> &segmentTokenContainerVector);
+void checkPublicLabels(const map<string, CodePosition> &publicLabelMap, const map<string, Label> &labelMap);
 
 #endif
@@ -84,10 +84,10 @@ auto convertToMathOperationVector(const vector<TokenContainer> &tokenContainerVe
 };
 
 RawInstructionSentence::RawInstructionSentence(const PseudoSentence &pseudoSentence, const map<string, Label> &labelMap) :
-    RawSentence(pseudoSentence.baseTokenContainer.pos, pseudoSentence.assume),
+    RawSentenceBase(pseudoSentence.baseTokenContainer.pos, pseudoSentence.assume),
     instruction(pseudoSentence.baseTokenContainer.token.value<Token::Instruction>())
 {
-    typedef vector<TokenContainer>::const_iterator ItType;
+    typedef ArenaVector<TokenContainer>::const_iterator ItType;
 
     auto locateMemoryBracketExpression = [](ItType it, ItType endIt) -> ItType {
         if ((it == endIt) ||
@@ -120,10 +120,10 @@ RawInstructionSentence::RawInstructionSentence(const PseudoSentence &pseudoSente
         return true;
     };
 
-    const vector<vector<TokenContainer>> &operandsTokenContainerVector = pseudoSentence.operandsTokenContainerVector;
+    const ArenaVector<ArenaVector<TokenContainer>> &operandsTokenContainerVector = pseudoSentence.operandsTokenContainerVector;
 
     for (auto it = operandsTokenContainerVector.begin(); it != operandsTokenContainerVector.end(); ++it) {
-        const vector<TokenContainer> &tokenContainerVector = *it;
+        const ArenaVector<TokenContainer> &tokenContainerVector = *it;
 
         if (tokenContainerVector.size() == 1) {
             const Token &token = tokenContainerVector[0].token;
@@ -186,7 +186,7 @@ RawInstructionSentence::RawInstructionSentence(const PseudoSentence &pseudoSente
 
         while (jt != tokenContainerVector.end()) {
             auto bracketEndIt = locateMemoryBracketExpression(jt, tokenContainerVector.end());
-            rawOperandTokenContainerVectors.push_back({jt + 1, bracketEndIt - 1});
+            rawOperandTokenContainerVectors.push_back(vector<TokenContainer>(jt + 1, bracketEndIt - 1));
             jt = bracketEndIt;
         }
 
@@ -593,10 +593,10 @@ string RawInstructionSentence::Operand::present(const map<string, Label> &labelM
 }
 
 RawDataSentence::RawDataSentence(const PseudoSentence &pseudoSentence, const map<string, Label> &labelMap) :
-    RawSentence(pseudoSentence.baseTokenContainer.pos, pseudoSentence.assume),
+    RawSentenceBase(pseudoSentence.baseTokenContainer.pos, pseudoSentence.assume),
     dataIdentifier(pseudoSentence.baseTokenContainer.token.value<Token::DataIdentifier>())
 {
-    const vector<vector<TokenContainer>> &operandsTokenContainerVector = pseudoSentence.operandsTokenContainerVector;
+    const ArenaVector<ArenaVector<TokenContainer>> &operandsTokenContainerVector = pseudoSentence.operandsTokenContainerVector;
 
     for (auto it = operandsTokenContainerVector.begin(); it != operandsTokenContainerVector.end(); ++it) {
         CodePosition operandPos = calculatePos(it->begin(), it->end());
@@ -703,13 +703,14 @@ vector<RawSentencesSegment> constructRawSentences(const vector<PseudoSentencesSe
     vector<RawSentencesSegment> rawSentencesSegmentContainerVector;
 
     for (auto it = pseudoSentencesSegmentContainerVector.begin(); it != pseudoSentencesSegmentContainerVector.end(); ++it) {
-        vector<shared_ptr<RawSentence>> rawSentenceVector;
+        ArenaVector<RawSentence> rawSentenceVector;
+        rawSentenceVector.reserve(it->pseudoSentences.size());
 
         for (auto jt = it->pseudoSentences.begin(); jt != it->pseudoSentences.end(); ++jt) {
             if (jt->baseTokenContainer.token.type() == Token::Type::INSTRUCTION)
-                rawSentenceVector.push_back(shared_ptr<RawSentence>(new RawInstructionSentence(*jt, labelMap)));
+                rawSentenceVector.emplace_back(RawInstructionSentence(*jt, labelMap));
             else
-                rawSentenceVector.push_back(shared_ptr<RawSentence>(new RawDataSentence(*jt, labelMap)));
+                rawSentenceVector.emplace_back(RawDataSentence(*jt, labelMap));
         }
 
         rawSentencesSegmentContainerVector.push_back({it->segName, rawSentenceVector});
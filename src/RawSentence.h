@@ -8,6 +8,8 @@
 #include "PseudoSentence.h"
 #include "UniquePtr.h"
 #include "Sentence.h"
+#include "Arena.h"
+#include "Variant.h"
 
 struct RawNumber {
     Integer num;
@@ -15,22 +17,18 @@ struct RawNumber {
     bool isNotFinal;
 };
 
-class SentenceSize;
-
-class RawSentence {
+class RawSentenceBase {
 public:
-    virtual tuple<string, vector<string>> present(const map<string, Label> &labelMap) const = 0;
-    
-    inline RawSentence(CodePosition pos, Assume assume) :
+    inline RawSentenceBase(CodePosition pos, Assume assume) :
         _pos(pos),
         _assume(assume)
     {}
 
-    inline CodePosition pos() const {
+    inline const CodePosition &pos() const {
         return _pos;
     }
 
-    inline Assume assume() const {
+    inline const Assume &assume() const {
         return _assume;
     }
 private:
@@ -38,7 +36,7 @@ private:
     Assume _assume;
 };
 
-class RawInstructionSentence : public RawSentence {
+class RawInstructionSentence : public RawSentenceBase {
 public:
     typedef InstructionSentence::SegmentPrefix SegmentPrefix;
 
@@ -53,35 +51,66 @@ public:
     typedef tuple<Operand, CodePosition> OperandContainer;
 
     RawInstructionSentence(const PseudoSentence &pseudoSentence, const map<string, Label> &labelMap);
-    virtual tuple<string, vector<string>> present(const map<string, Label> &labelMap) const override;
+    tuple<string, vector<string>> present(const map<string, Label> &labelMap) const;
 private:
     optional<SegmentPrefix> segmentPrefix;
     Instruction instruction;
-    vector<OperandContainer> operandContainerVector;
+    ArenaVector<OperandContainer> operandContainerVector;
 
-    friend shared_ptr<Sentence> constructSentenceFromRaw(const RawSentence &rawSentence, vector<bool> linkVector);
-    friend vector<SentencesSegment> constructSentences(const vector<RawSentencesSegment> &rawSentencesSegmentContainer);
+    friend InstructionSentence constructInstructionSentenceFromRaw(const RawInstructionSentence &rawInstructionSentence, const vector<bool> &linkVector);
+    friend vector<SentencesSegment> constructSentences(const vector<RawSentencesSegment> &rawSentencesSegmentContainer, size_t origin, bool isRelocatable);
 };
 
-class RawDataSentence : public RawSentence {
+class RawDataSentence : public RawSentenceBase {
 public:
     typedef RawNumber Operand;
     typedef tuple<Operand, CodePosition> OperandContainer;
     typedef InstructionNS::DataIdentifier DataIdentifier;
 
     RawDataSentence(const PseudoSentence &pseudoSentence, const map<string, Label> &labelMap);
-    virtual tuple<string, vector<string>> present(const map<string, Label> &labelMap) const override;
+    tuple<string, vector<string>> present(const map<string, Label> &labelMap) const;
 private:
     DataIdentifier dataIdentifier;
-    vector<OperandContainer> operandContainerVector;
+    ArenaVector<OperandContainer> operandContainerVector;
+
+    friend DataSentence constructDataSentenceFromRaw(const RawDataSentence &rawDataSentence);
+    friend vector<SentencesSegment> constructSentences(const vector<RawSentencesSegment> &rawSentencesSegmentContainer, size_t origin, bool isRelocatable);
+};
+
+class RawSentence : public Variant<RawInstructionSentence, RawDataSentence> {
+public:
+    inline RawSentence(RawInstructionSentence rawInstructionSentence) :
+        Variant(std::move(rawInstructionSentence))
+    {}
+
+    inline RawSentence(RawDataSentence rawDataSentence) :
+        Variant(std::move(rawDataSentence))
+    {}
 
-    friend shared_ptr<Sentence> constructSentenceFromRaw(const RawSentence &rawSentence, vector<bool> linkVector);
-    friend vector<SentencesSegment> constructSentences(const vector<RawSentencesSegment> &rawSentencesSegmentContainer);
+    inline tuple<string, vector<string>> present(const map<string, Label> &labelMap) const {
+        return visit([&](const auto &rawSentence) {
+            return rawSentence.present(labelMap);
+        });
+    }
+
+    inline const CodePosition &pos() const {
+        return base().pos();
+    }
+
+    inline const Assume &assume() const {
+        return base().assume();
+    }
+private:
+    inline const RawSentenceBase &base() const {
+        return visit([](const RawSentenceBase &rawSentence) -> const RawSentenceBase & {
+            return rawSentence;
+        });
+    }
 };
 
 struct RawSentencesSegment {
     string segName;
-    vector<shared_ptr<RawSentence>> rawSentences;
+    ArenaVector<RawSentence> rawSentences;
 };
 
 RawInstructionSentence::SegmentPrefix getSegmentOverridePrefix(Token::Register reg);
@@ -0,0 +1,27 @@
+#ifndef _SCOPEDCURRENT_H_
+#define _SCOPEDCURRENT_H_
+
+#include "Global.h"
+
+template<typename T>
+class ScopedCurrent {
+public:
+    inline ScopedCurrent(T &current, T value) :
+        current(current),
+        previousValue(current)
+    {
+        current = value;
+    }
+
+    inline ~ScopedCurrent() {
+        current = previousValue;
+    }
+
+    ScopedCurrent(const ScopedCurrent &) = delete;
+    ScopedCurrent &operator=(const ScopedCurrent &) = delete;
+private:
+    T &current;
+    T previousValue;
+};
+
+#endif
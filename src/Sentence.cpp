@@ -2,44 +2,61 @@
 
 #include "RawSentence.h"
 #include "Instruction.h"
+#include "Compiler.h"
 #include "Exception.h"
+#include "Trace.h"
+#include "Stats.h"
 #include "Diagnostics.h"
 #include <algorithm>
 
 using namespace OperandMask;
 
-vector<InstructionNS::Definition> findSuitableDefinitions(const InstructionSentence &instructionSentence) {
-    vector<InstructionNS::Definition> suitableDefinitions;
-
-    for (auto it = InstructionNS::instructionDefinitionVector.begin(); it != InstructionNS::instructionDefinitionVector.end(); ++it) {
-        if ((instructionSentence.instruction == it->instruction) &&
-            (instructionSentence.operandContainerVector.size() == it->operandFullMasks.size()))
-        {
-            bool isSuitable = true;
-            for (size_t i = 0; i < instructionSentence.operandContainerVector.size(); ++i) {
-                const OperandMask::Mask &opMask = get<0>(instructionSentence.operandContainerVector[i]).mask;
-                const OperandMask::Mask &defOpMask = it->operandFullMasks[i].mask;
-
-                if ((!defOpMask.match(opMask)) ||
-                    ((it->operandFullMasks[i].num) &&
-                     (*it->operandFullMasks[i].num != get<0>(instructionSentence.operandContainerVector[i]).num)))
-                {
-                    isSuitable = false;
-                    break;
-                }
-            }
+InstructionNS::DefinitionKey getDefinitionKey(const InstructionSentence &instructionSentence) {
+    InstructionNS::DefinitionKey key(instructionSentence.instruction);
+    for (auto it = instructionSentence.operandContainerVector.begin(); it != instructionSentence.operandContainerVector.end(); ++it)
+        key.addOperand(get<0>(*it).mask);
+
+    return key;
+}
+
+vector<const InstructionNS::Definition *> findSuitableDefinitions(const InstructionSentence &instructionSentence) {
+    vector<const InstructionNS::Definition *> suitableDefinitions;
+
+    const vector<const InstructionNS::Definition *> &candidates = InstructionNS::findDefinitionCandidates(getDefinitionKey(instructionSentence));
+
+    Stats *stats = Stats::current();
+    if (stats) {
+        ++stats->definitionLookups;
+        stats->definitionsProbed += candidates.size();
+    }
 
-            if (isSuitable)
-                suitableDefinitions.push_back(*it);
+    for (auto it = candidates.begin(); it != candidates.end(); ++it) {
+        const InstructionNS::Definition &definition = **it;
+
+        bool isSuitable = true;
+        for (size_t i = 0; i < instructionSentence.operandContainerVector.size(); ++i) {
+            const OperandMask::Mask &opMask = get<0>(instructionSentence.operandContainerVector[i]).mask;
+            const OperandMask::Mask &defOpMask = definition.operandFullMasks[i].mask;
+
+            if ((!defOpMask.match(opMask)) ||
+                ((definition.operandFullMasks[i].num) &&
+                 (*definition.operandFullMasks[i].num != get<0>(instructionSentence.operandContainerVector[i]).num)))
+            {
+                isSuitable = false;
+                break;
+            }
         }
+
+        if (isSuitable)
+            suitableDefinitions.push_back(&definition);
     }
 
     return suitableDefinitions;
 }
 
-InstructionNS::Definition findMostSuitableDefinition(const InstructionSentence &instructionSentence, const vector<InstructionNS::Definition> &suitableDefinitions) {
-    auto getFullSuitableRank = [](const vector<InstructionSentence::OperandContainer> &operandContainerVector,
-                                  const InstructionNS::Definition definition) -> size_t {
+const InstructionNS::Definition &findMostSuitableDefinition(const InstructionSentence &instructionSentence, const vector<const InstructionNS::Definition *> &suitableDefinitions) {
+    auto getFullSuitableRank = [](const ArenaVector<InstructionSentence::OperandContainer> &operandContainerVector,
+                                  const InstructionNS::Definition &definition) -> size_t {
         auto getSuitableRank = [](const OperandMask::Mask &baseMask, const OperandMask::Mask &mask) -> size_t {
             size_t rank = (baseMask ^ mask).count();
             
@@ -61,28 +78,138 @@ InstructionNS::Definition findMostSuitableDefinition(const InstructionSentence &
         throw CompileError("incorrect instruction or operand", instructionSentence.pos);
 
     for (auto it = suitableDefinitions.begin(); it != suitableDefinitions.end(); ++it) {
-        for (auto jt = it->operandFullMasks.begin(); jt != it->operandFullMasks.end(); ++jt) {
+        for (auto jt = (*it)->operandFullMasks.begin(); jt != (*it)->operandFullMasks.end(); ++jt) {
             if (jt->num)
-                return *it;
+                return **it;
         }
     }
 
-    InstructionNS::Definition mostSuitableDefinition = suitableDefinitions[0];
+    const InstructionNS::Definition *mostSuitableDefinition = suitableDefinitions[0];
 
-    const vector<InstructionSentence::OperandContainer> &operandContainerVector = instructionSentence.operandContainerVector;
+    Stats *stats = Stats::current();
+    if (stats) {
+        ++stats->definitionRankings;
+        stats->definitionsRanked += suitableDefinitions.size();
+    }
+
+    const ArenaVector<InstructionSentence::OperandContainer> &operandContainerVector = instructionSentence.operandContainerVector;
     
     for (size_t i = 1; i < suitableDefinitions.size(); ++i) {
-        if (getFullSuitableRank(operandContainerVector, suitableDefinitions[i]) < getFullSuitableRank(operandContainerVector, mostSuitableDefinition))
+        if (getFullSuitableRank(operandContainerVector, *suitableDefinitions[i]) < getFullSuitableRank(operandContainerVector, *mostSuitableDefinition))
             mostSuitableDefinition = suitableDefinitions[i];
     }
 
-    return mostSuitableDefinition;
+    return *mostSuitableDefinition;
 }
 
-vector<vector<uchar>> InstructionSentence::compute() const {
-    InstructionNS::Definition definition = findMostSuitableDefinition(*this, findSuitableDefinitions(*this));
+class EncodingKey {
+public:
+    class OperandKey {
+    public:
+        inline bool operator<(const OperandKey &key) const {
+            return std::tie(mask, isLinkable, numClass, segReg) < std::tie(key.mask, key.isLinkable, key.numClass, key.segReg);
+        }
 
-    return definition.computeFunc(definition, *this);
+        OperandMask::Mask mask;
+        bool isLinkable;
+        int numClass;
+        OperandMask::Mask segReg;
+    };
+
+    EncodingKey(const InstructionSentence &instructionSentence);
+
+    inline bool operator<(const EncodingKey &key) const {
+        return std::tie(arch, instruction, segmentPrefix, operandKeyVector) < std::tie(key.arch, key.instruction, key.segmentPrefix, key.operandKeyVector);
+    }
+private:
+    Compiler::Arch arch;
+    InstructionSentence::Instruction instruction;
+    int segmentPrefix;
+    vector<OperandKey> operandKeyVector;
+};
+
+EncodingKey::EncodingKey(const InstructionSentence &instructionSentence) :
+    arch(Compiler::arch),
+    instruction(instructionSentence.instruction),
+    segmentPrefix(instructionSentence.segmentPrefix ? static_cast<int>(*instructionSentence.segmentPrefix) : -1)
+{
+    operandKeyVector.reserve(instructionSentence.operandContainerVector.size());
+
+    for (auto it = instructionSentence.operandContainerVector.begin(); it != instructionSentence.operandContainerVector.end(); ++it) {
+        const InstructionSentence::Operand &op = get<0>(*it);
+        OperandKey operandKey = {op.mask, op.isLinkable, -1, Mask()};
+
+        if (op.mask.match(MEM)) {
+            if (op.num == 0)
+                operandKey.numClass = 0;
+            else if (op.num.sizeSigned())
+                operandKey.numClass = static_cast<int>(*op.num.sizeSigned()) + 1;
+            else
+                operandKey.numClass = static_cast<int>(Integer::Size::S_64) + 2;
+
+            if (op.segName) {
+                const auto &assumeMap = instructionSentence.assume.getMap();
+                auto assumeSegmentIt = assumeMap.find(*op.segName);
+                if (assumeSegmentIt != assumeMap.end())
+                    operandKey.segReg = assumeSegmentIt->second;
+            }
+        }
+
+        operandKeyVector.push_back(operandKey);
+    }
+}
+
+void InstructionSentence::encode(ByteEmitter &emitter, vector<Relocation> *relocationVector) const {
+    static thread_local map<EncodingKey, optional<InstructionNS::Encoding>> encodingCache;
+
+    auto emitEncoding = [&](const InstructionNS::Encoding &encoding) {
+        size_t base = emitter.size();
+        encoding.emit(emitter, *this);
+
+        if (relocationVector) {
+            for (auto it = encoding.valuePatches.begin(); it != encoding.valuePatches.end(); ++it) {
+                const Operand &op = get<0>(operandContainerVector[it->operand]);
+
+                if (op.isLinkable && op.segName)
+                    relocationVector->push_back({base + it->offset, it->size, *op.segName, op.mask.match(REL)});
+            }
+        }
+    };
+
+    EncodingKey key(*this);
+    auto it = encodingCache.find(key);
+    if ((it != encodingCache.end()) && it->second) {
+        emitEncoding(*it->second);
+        return;
+    }
+
+    const InstructionNS::Definition &definition = findMostSuitableDefinition(*this, findSuitableDefinitions(*this));
+
+    InstructionNS::Encoding encoding;
+    definition.computeFunc(definition, *this, encoding);
+
+    if (it == encodingCache.end()) {
+        const vector<const InstructionNS::Definition *> &candidates = InstructionNS::findDefinitionCandidates(getDefinitionKey(*this));
+        bool isValueDependent = std::any_of(candidates.begin(), candidates.end(), [](const InstructionNS::Definition *candidate) {
+            return candidate->hasFixedOperandValue();
+        });
+
+        if (isValueDependent)
+            encodingCache.emplace(key, nullopt);
+        else
+            encodingCache.emplace(key, encoding);
+    }
+
+    emitEncoding(encoding);
+}
+
+size_t InstructionSentence::encodedSize() const {
+    static thread_local ByteEmitter emitter;
+
+    emitter.clear();
+    encode(emitter);
+
+    return emitter.size();
 }
 
 string InstructionSentence::Operand::present() const {
@@ -196,9 +323,7 @@ tuple<string, vector<string>> InstructionSentence::present() const {
     return make_tuple(instructionStr, operandStrVector);
 }
 
-vector<vector<uchar>> DataSentence::compute() const {
-    vector<vector<uchar>> res;
-
+Integer::Size DataSentence::operandSize() const {
     Integer::Size intSize;
     switch (dataIdentifier) {
     case DataIdentifier::DB:
@@ -212,12 +337,25 @@ vector<vector<uchar>> DataSentence::compute() const {
         break;
     }
 
+    return intSize;
+}
+
+void DataSentence::encode(ByteEmitter &emitter, vector<Relocation> *relocationVector) const {
+    Integer::Size intSize = operandSize();
+    size_t byteCount = Integer::getByteCount(intSize);
+
     for (auto it = operandContainerVector.begin(); it != operandContainerVector.end(); ++it) {
-        vector<uchar> opRes = get<0>(*it).getCharArrayUnsigned(intSize);
-        res.push_back(opRes);
+        const Operand &op = get<0>(*it);
+
+        if (relocationVector && op.segName)
+            relocationVector->push_back({emitter.size(), intSize, *op.segName, false});
+
+        op.num.putCharArray(intSize, emitter.emitField(byteCount));
     }
+}
 
-    return res;
+size_t DataSentence::encodedSize() const {
+    return Integer::getByteCount(operandSize()) * operandContainerVector.size();
 }
 
 tuple<string, vector<string>> DataSentence::present() const {
@@ -225,50 +363,54 @@ tuple<string, vector<string>> DataSentence::present() const {
 
     vector<string> operandStrVector;
     for (auto it = operandContainerVector.begin(); it != operandContainerVector.end(); ++it)
-        operandStrVector.push_back(get<0>(*it).str());
+        operandStrVector.push_back(get<0>(*it).num.str());
 
     return make_tuple(instructionStr, operandStrVector);
 }
 
-shared_ptr<Sentence> constructSentenceFromRaw(const RawSentence &rawSentence, vector<bool> linkVector = vector<bool>()) {
-    if (typeid(rawSentence) == typeid(RawInstructionSentence)) {
-        const RawInstructionSentence &rawInstructionSentence = static_cast<const RawInstructionSentence &>(rawSentence);
+InstructionSentence constructInstructionSentenceFromRaw(const RawInstructionSentence &rawInstructionSentence, const vector<bool> &linkVector = vector<bool>()) {
+    ArenaVector<InstructionSentence::OperandContainer> operandContainerVector;
+    operandContainerVector.reserve(rawInstructionSentence.operandContainerVector.size());
 
-        vector<InstructionSentence::OperandContainer> operandContainerVector;
-        for (auto it = rawInstructionSentence.operandContainerVector.begin(); it != rawInstructionSentence.operandContainerVector.end(); ++it) {
-            const RawInstructionSentence::Operand &rawOperand = get<0>(*it);
-            bool isLinkable = ((size_t)(it - rawInstructionSentence.operandContainerVector.begin()) < linkVector.size()) ? linkVector[it - rawInstructionSentence.operandContainerVector.begin()] : false;
-            
-            optional<string> segName = nullopt;
-            if (rawOperand.rawNum.label)
-                segName = (*rawOperand.rawNum.label).segName;
+    for (auto it = rawInstructionSentence.operandContainerVector.begin(); it != rawInstructionSentence.operandContainerVector.end(); ++it) {
+        const RawInstructionSentence::Operand &rawOperand = get<0>(*it);
+        bool isLinkable = ((size_t)(it - rawInstructionSentence.operandContainerVector.begin()) < linkVector.size()) ? linkVector[it - rawInstructionSentence.operandContainerVector.begin()] : false;
+        
+        optional<string> segName = nullopt;
+        if (rawOperand.rawNum.label)
+            segName = (*rawOperand.rawNum.label).segName;
 
-            operandContainerVector.push_back(InstructionSentence::OperandContainer({rawOperand.mask, rawOperand.rawNum.num, isLinkable, segName}, get<1>(*it)));
-        }
+        operandContainerVector.push_back(InstructionSentence::OperandContainer({rawOperand.mask, rawOperand.rawNum.num, isLinkable, segName}, get<1>(*it)));
+    }
+
+    return InstructionSentence(rawInstructionSentence.pos(),
+                               rawInstructionSentence.assume(),
+                               rawInstructionSentence.segmentPrefix,
+                               rawInstructionSentence.instruction,
+                               std::move(operandContainerVector));
+}
 
-        return shared_ptr<Sentence>(new InstructionSentence(rawInstructionSentence.pos(),
-                                                                rawInstructionSentence.assume(),
-                                                                rawInstructionSentence.segmentPrefix,
-                                                                rawInstructionSentence.instruction,
-                                                                operandContainerVector));
-    } else {
-        const RawDataSentence &rawDataSentence = static_cast<const RawDataSentence &>(rawSentence);
+DataSentence constructDataSentenceFromRaw(const RawDataSentence &rawDataSentence) {
+    ArenaVector<DataSentence::OperandContainer> operandContainerVector;
+    operandContainerVector.reserve(rawDataSentence.operandContainerVector.size());
 
-        vector<DataSentence::OperandContainer> operandContainerVector;
-        for (auto it = rawDataSentence.operandContainerVector.begin(); it != rawDataSentence.operandContainerVector.end(); ++it) {
-            const RawDataSentence::Operand &rawOperand = get<0>(*it);
+    for (auto it = rawDataSentence.operandContainerVector.begin(); it != rawDataSentence.operandContainerVector.end(); ++it) {
+        const RawDataSentence::Operand &rawOperand = get<0>(*it);
 
-            operandContainerVector.push_back(DataSentence::OperandContainer(rawOperand.num, get<1>(*it)));
-        }
+        optional<string> segName = nullopt;
+        if (rawOperand.label)
+            segName = (*rawOperand.label).segName;
 
-        return shared_ptr<Sentence>(new DataSentence(rawDataSentence.pos(),
-                                                         rawDataSentence.assume(),
-                                                         rawDataSentence.dataIdentifier,
-                                                         operandContainerVector));
+        operandContainerVector.push_back(DataSentence::OperandContainer({rawOperand.num, segName}, get<1>(*it)));
     }
+
+    return DataSentence(rawDataSentence.pos(),
+                        rawDataSentence.assume(),
+                        rawDataSentence.dataIdentifier,
+                        std::move(operandContainerVector));
 }
 
-vector<SentencesSegment> constructSentences(const vector<RawSentencesSegment> &rawSentencesSegmentContainerVector) {
+vector<SentencesSegment> constructSentences(const vector<RawSentencesSegment> &rawSentencesSegmentContainerVector, size_t origin, bool isRelocatable) {
     auto instructionOperandImplicitSizeSetter = [](InstructionSentence::Operand &operand) {
         if (operand.mask.match(IMM) && (!operand.mask.matchAny(S_ANY)))
             operand.mask |= Mask::operandSizeFromIntegerSize(operand.num.sizeAny());
@@ -299,317 +441,152 @@ vector<SentencesSegment> constructSentences(const vector<RawSentencesSegment> &r
             break;
         }
 
-        if (get<0>(operandContainer).sizeAny() > suitableSize)
+        if (get<0>(operandContainer).num.sizeAny() > suitableSize)
             throw CompileError("overflow (constant size too large)", get<1>(operandContainer));
     };
 
-    struct DispsSegmentContainer {
-        string segName;
-        vector<optional<size_t>> dispVector;
-    };
+    auto getLinkVectorFromRawSentence = [](const RawInstructionSentence &rawInstructionSentence) -> vector<bool> {
+        vector<bool> res;
 
-    class DispsSegmentFinder {
-    public:
-        inline DispsSegmentFinder(string segName) :
-            segName(segName)
-        {}
+        for (auto it = rawInstructionSentence.operandContainerVector.begin(); it != rawInstructionSentence.operandContainerVector.end(); ++it)
+            res.push_back((bool)get<0>(*it).rawNum.label);
 
-        const string segName;
+        return res;
+    };
 
-        inline bool operator()(const DispsSegmentContainer &dispsSegmentContainer) const {
-            return segName == dispsSegmentContainer.segName;
-        }
+    auto isDependentOperand = [](const RawInstructionSentence::Operand &operand) -> bool {
+        return operand.rawNum.isNotFinal && (!(operand.mask.match(IMM) && operand.mask.matchAny(S_ANY)));
     };
 
-    class RawSentencesSegmentFinder {
-    public:
-        inline RawSentencesSegmentFinder(string segName) :
-            segName(segName)
-        {}
+    struct SpanDependentSentence {
+        size_t segIndex;
+        size_t index;
+        vector<size_t> operandIndexVector;
+        vector<Integer::Size> operandSizeVector;
+    };
 
-        const string segName;
+    map<string, size_t> segIndexMap;
+    for (size_t segIndex = 0; segIndex < rawSentencesSegmentContainerVector.size(); ++segIndex)
+        segIndexMap[rawSentencesSegmentContainerVector[segIndex].segName] = segIndex;
 
-        inline bool operator()(const RawSentencesSegment &rawSentencesSegmentContainer) {
-            return segName == rawSentencesSegmentContainer.segName;
-        }
+    vector<vector<size_t>> sizeVectors(rawSentencesSegmentContainerVector.size());
+    vector<OffsetTable> offsetTables;
+    vector<SpanDependentSentence> spanDependentSentenceVector;
+    vector<vector<size_t>> spanDependentIndexVectors(rawSentencesSegmentContainerVector.size());
+    constexpr size_t notSpanDependent = static_cast<size_t>(-1);
+
+    auto getLabelOffset = [&](const Label &label) -> size_t {
+        return origin + offsetTables[segIndexMap.find(label.segName)->second].offset(label.ptr);
     };
 
-    auto computeDisp = [](vector<optional<size_t>>::const_iterator begin,
-                          vector<optional<size_t>>::const_iterator end) -> size_t {
-        size_t disp = 0;
-        for (auto it = begin; it != end; ++it)
-            disp += **it;
+    auto getSentenceEndOffset = [&](size_t segIndex, size_t index) -> size_t {
+        return origin + offsetTables[segIndex].offset(index + 1);
+    };
 
-        return disp;
+    auto getSourceRawInstructionSentence = [&](const SpanDependentSentence &spanDependentSentence) -> const RawInstructionSentence & {
+        return rawSentencesSegmentContainerVector[spanDependentSentence.segIndex].rawSentences[spanDependentSentence.index].get<RawInstructionSentence>();
     };
 
-    auto getLinkVectorFromRawSentence = [](const RawInstructionSentence &rawInstructionSentence) -> vector<bool> {
-        vector<bool> res;
+    auto computeTrialSize = [&](const SpanDependentSentence &spanDependentSentence) -> optional<size_t> {
+        const RawInstructionSentence &sourceRawInstructionSentence = getSourceRawInstructionSentence(spanDependentSentence);
+        RawInstructionSentence rawInstructionSentence = sourceRawInstructionSentence;
+        auto &rawOperandContainerVector = rawInstructionSentence.operandContainerVector;
 
-        for (auto it = rawInstructionSentence.operandContainerVector.begin(); it != rawInstructionSentence.operandContainerVector.end(); ++it)
-            res.push_back((bool)get<0>(*it).rawNum.label);
+        for (auto it = rawOperandContainerVector.begin(); it != rawOperandContainerVector.end(); ++it)
+            get<0>(*it).rawNum.isNotFinal = false;
 
-        return res;
-    };
+        for (size_t k = 0; k < spanDependentSentence.operandIndexVector.size(); ++k) {
+            auto &operand = get<0>(rawOperandContainerVector[spanDependentSentence.operandIndexVector[k]]);
+            Integer::Size size = spanDependentSentence.operandSizeVector[k];
 
-    typedef function<vector<DispsSegmentContainer>(vector<DispsSegmentContainer>, vector<RawSentencesSegment>::const_iterator)> recursiveSizeComputerT;
-    recursiveSizeComputerT recursiveSizeComputer = [&](vector<DispsSegmentContainer> dispsSegmentContainerVector,
-                                                       vector<RawSentencesSegment>::const_iterator segIt) -> vector<DispsSegmentContainer> {
-        for (size_t i = 0; i < segIt->rawSentences.size(); ++i) {
-            auto dispsSegmentContainerIt = std::find_if(dispsSegmentContainerVector.begin(),
-                                                        dispsSegmentContainerVector.end(),
-                                                        DispsSegmentFinder(segIt->segName));
-            auto &dispVector = dispsSegmentContainerIt->dispVector;
-
-            if (dispVector[i])
-                continue;
-
-            shared_ptr<RawSentence> sentencePtr = segIt->rawSentences[i];
-            if (typeid(*sentencePtr) == typeid(RawInstructionSentence)) {
-                RawInstructionSentence &sourceRawInstructionSentence = static_cast<RawInstructionSentence &>(*sentencePtr);
-                RawInstructionSentence rawInstructionSentence = sourceRawInstructionSentence;
-                auto &rawOperandContainerVector = rawInstructionSentence.operandContainerVector;
+            if (operand.mask.match(MEM) || operand.mask.match(REL))
+                operand.rawNum.num = Integer::getMaxValSigned(size);
+            else
+                operand.rawNum.num = Integer::getMaxValAny(size);
+        }
 
-                if (InstructionNS::jumpInstructionsSet.count(rawInstructionSentence.instruction) &&
-                    (rawOperandContainerVector.size() == 1) &&
-                    get<0>(rawOperandContainerVector[0]).mask.match(REL))
-                {
-                    RawInstructionSentence::Operand jmpRawOperand = get<0>(rawOperandContainerVector[0]);
-
-                    if (!jmpRawOperand.rawNum.isNotFinal) {
-                        shared_ptr<Sentence> sentence = constructSentenceFromRaw(rawInstructionSentence);
-                        InstructionSentence &instructionSentence = static_cast<InstructionSentence &>(*sentence);
-                        auto &operandContainerVector = instructionSentence.operandContainerVector;
-                        auto &jmpOperandContainer = operandContainerVector[0];
-                        auto &jmpOperand = get<0>(jmpOperandContainer);
-                        
-                        instructionOperandImplicitSizeSetter(jmpOperand);
-
-                        dispVector[i] = getInstructionBytePresentSize(instructionSentence.compute());
-                    } else {
-                        Label labelTo = *jmpRawOperand.rawNum.label;
-                        Label labelFrom = {nullopt, i + 1, segIt->segName};
-
-                        bool sizeComputed = false;
-                        for (Integer::Size innerRelSize = Integer::Size::S_8; innerRelSize != Integer::Size::S_64; innerRelSize = Integer::nextSize(innerRelSize)) {
-                            RawInstructionSentence innerRawInstructionSentence = rawInstructionSentence;
-                            auto &innerRawOperandContainerVector = innerRawInstructionSentence.operandContainerVector;
-                            auto &innerRawJmpOperandContainer= innerRawOperandContainerVector[0];
-                            auto &innerRawJmpOperand = get<0>(innerRawJmpOperandContainer);
-
-                            innerRawJmpOperand.rawNum.num = Integer::getMaxValSigned(innerRelSize);
-                            innerRawJmpOperand.rawNum.isNotFinal = false;
-
-                            shared_ptr<Sentence> innerSentence = constructSentenceFromRaw(innerRawInstructionSentence);
-                            InstructionSentence &innerInstructionSentence = static_cast<InstructionSentence &>(*innerSentence);
-                            auto &innerOperandContainerVector = innerInstructionSentence.operandContainerVector;
-                            auto &innerJmpOperandContainer = innerOperandContainerVector[0];
-                            auto &innerJmpOperand = get<0>(innerJmpOperandContainer);
-
-                            instructionOperandImplicitSizeSetter(innerJmpOperand);
-
-                            auto innerDispsSegmentContainerVector = dispsSegmentContainerVector;
-                            auto innerDispsSegmentContainerIt = std::find_if(innerDispsSegmentContainerVector.begin(),
-                                                                             innerDispsSegmentContainerVector.end(),
-                                                                             DispsSegmentFinder(segIt->segName));
-                            auto &innerDispVector = innerDispsSegmentContainerIt->dispVector;
-
-                            if (!findSuitableDefinitions(innerInstructionSentence).empty()) {
-                                innerDispVector[i] = getInstructionBytePresentSize(innerInstructionSentence.compute());
-
-                                auto innerRawSegIt = std::find_if(rawSentencesSegmentContainerVector.begin(),
-                                                                  rawSentencesSegmentContainerVector.end(),
-                                                                  RawSentencesSegmentFinder(segIt->segName));
-
-                                innerDispsSegmentContainerVector = recursiveSizeComputer(innerDispsSegmentContainerVector,
-                                                                                         innerRawSegIt);
-
-                                auto innerSegIt = std::find_if(innerDispsSegmentContainerVector.begin(),
-                                                               innerDispsSegmentContainerVector.end(),
-                                                               DispsSegmentFinder(segIt->segName));
-
-                                Integer curInnerLabelToDisp = computeDisp(innerSegIt->dispVector.begin(),
-                                                                            innerSegIt->dispVector.begin() + labelTo.ptr);
-                                Integer curInnerLabelFromDisp = computeDisp(innerSegIt->dispVector.begin(),
-                                                                              innerSegIt->dispVector.begin() + labelFrom.ptr);
-                                Integer curInnerRel = curInnerLabelToDisp + jmpRawOperand.rawNum.num - curInnerLabelFromDisp;
-
-                                Integer::Size curInnerOpSize = *curInnerRel.sizeSigned();
-
-                                Integer::Size curInnerNeedOpSize = innerRelSize;
-
-                                if (curInnerOpSize <= curInnerNeedOpSize) {
-                                    dispsSegmentContainerVector = innerDispsSegmentContainerVector;
-                                    sizeComputed = true;
-                                    break;
-                                }
-                            }
-                        }
-
-                        if (!sizeComputed)
-                            throw CompileError("incorrect instruction or operand", rawInstructionSentence.pos());
-                    }
-                } else {
-                    vector<RawInstructionSentence::OperandContainer *> rawOperandContainerDependVector;
-                    
-                    if (InstructionNS::jumpInstructionsSet.count(rawInstructionSentence.instruction) &&
-                        (rawOperandContainerVector.size() == 1) &&
-                        get<0>(rawOperandContainerVector[0]).mask.match(REL))
-                    {
-                        RawInstructionSentence::Operand &operand = get<0>(rawOperandContainerVector[0]);
-
-                        if (operand.rawNum.isNotFinal)
-                            rawOperandContainerDependVector.push_back(&rawOperandContainerVector[0]);
-                    }
+        InstructionSentence instructionSentence = constructInstructionSentenceFromRaw(rawInstructionSentence, getLinkVectorFromRawSentence(sourceRawInstructionSentence));
+        auto &operandContainerVector = instructionSentence.operandContainerVector;
 
-                    for (auto it = rawOperandContainerVector.begin(); it != rawOperandContainerVector.end(); ++it) {
-                        if (get<0>(*it).rawNum.isNotFinal)
-                            rawOperandContainerDependVector.push_back(&*it);
-                    }
+        for (auto it = operandContainerVector.begin(); it != operandContainerVector.end(); ++it) {
+            instructionOperandImplicitSizeSetter(get<0>(*it));
+            instructionOperandSizeChecker(*it);
+        }
 
-                    for (auto it = rawOperandContainerDependVector.begin(); it != rawOperandContainerDependVector.end();) {
-                        RawInstructionSentence::Operand &operand = get<0>(**it);
+        if (findSuitableDefinitions(instructionSentence).empty())
+            return nullopt;
+
+        return instructionSentence.encodedSize();
+    };
+
+    auto sizeSpanDependentSentence = [&](SpanDependentSentence &spanDependentSentence) -> size_t {
+        while (true) {
+            auto trialSize = computeTrialSize(spanDependentSentence);
+            if (trialSize)
+                return *trialSize;
+
+            bool isGrown = false;
+            for (auto it = spanDependentSentence.operandSizeVector.begin(); it != spanDependentSentence.operandSizeVector.end(); ++it) {
+                if (*it != Integer::Size::S_64) {
+                    *it = Integer::nextSize(*it);
+                    isGrown = true;
+                }
+            }
 
-                        auto curLabelSegIt = std::find_if(dispsSegmentContainerVector.begin(),
-                                                          dispsSegmentContainerVector.end(),
-                                                          DispsSegmentFinder(operand.rawNum.label->segName));
+            if (!isGrown)
+                throw CompileError("incorrect instruction or operand", getSourceRawInstructionSentence(spanDependentSentence).pos());
+        }
+    };
 
-                        if ((operand.rawNum.label->ptr == 0) ||
-                            (curLabelSegIt->dispVector[operand.rawNum.label->ptr - 1]))
-                        {
-                            operand.rawNum.num += computeDisp(curLabelSegIt->dispVector.begin(),
-                                                              curLabelSegIt->dispVector.begin() + operand.rawNum.label->ptr);
-                            operand.rawNum.isNotFinal = false;
+    auto getRequiredOperandSize = [&](const SpanDependentSentence &spanDependentSentence, size_t k) -> Integer::Size {
+        const RawInstructionSentence &rawInstructionSentence = getSourceRawInstructionSentence(spanDependentSentence);
+        const auto &operand = get<0>(rawInstructionSentence.operandContainerVector[spanDependentSentence.operandIndexVector[k]]);
 
-                            it = rawOperandContainerDependVector.erase(it);
-                            continue;
-                        }
+        if (operand.mask.match(REL) && (operand.rawNum.label->segName != rawSentencesSegmentContainerVector[spanDependentSentence.segIndex].segName))
+            return (Compiler::arch == Compiler::Arch::X86_16) ? Integer::Size::S_16 : Integer::Size::S_32;
 
-                        if (operand.mask.match(IMM) && operand.mask.matchAny(S_ANY)) {
-                            operand.rawNum.isNotFinal = false;
+        Integer value = operand.rawNum.num + Integer(getLabelOffset(*operand.rawNum.label));
+        if (operand.mask.match(REL))
+            value -= Integer(getSentenceEndOffset(spanDependentSentence.segIndex, spanDependentSentence.index));
 
-                            it = rawOperandContainerDependVector.erase(it);
-                            continue;
-                        }
+        if (operand.mask.match(MEM) || operand.mask.match(REL))
+            return *value.sizeSigned();
+        else
+            return value.sizeAny();
+    };
 
-                        ++it;
+    for (size_t segIndex = 0; segIndex < rawSentencesSegmentContainerVector.size(); ++segIndex) {
+        TraceSpan span("size", rawSentencesSegmentContainerVector[segIndex].segName, "segment");
+        const ArenaVector<RawSentence> &rawSentenceVector = rawSentencesSegmentContainerVector[segIndex].rawSentences;
+        span.setArg("sentences", rawSentenceVector.size());
+        sizeVectors[segIndex].resize(rawSentenceVector.size());
+        spanDependentIndexVectors[segIndex].resize(rawSentenceVector.size(), notSpanDependent);
+
+        for (size_t i = 0; i < rawSentenceVector.size(); ++i) {
+            const RawSentence &rawSentence = rawSentenceVector[i];
+
+            if (rawSentence.is<RawInstructionSentence>()) {
+                const RawInstructionSentence &rawInstructionSentence = rawSentence.get<RawInstructionSentence>();
+                const auto &rawOperandContainerVector = rawInstructionSentence.operandContainerVector;
+
+                SpanDependentSentence spanDependentSentence = {segIndex, i, {}, {}};
+                for (size_t k = 0; k < rawOperandContainerVector.size(); ++k) {
+                    if (isDependentOperand(get<0>(rawOperandContainerVector[k]))) {
+                        spanDependentSentence.operandIndexVector.push_back(k);
+                        spanDependentSentence.operandSizeVector.push_back(Integer::Size::S_8);
                     }
+                }
 
-                    if (rawOperandContainerDependVector.empty()) {
-                        shared_ptr<Sentence> sentence = constructSentenceFromRaw(rawInstructionSentence, getLinkVectorFromRawSentence(sourceRawInstructionSentence));
-                        InstructionSentence &instructionSentence = static_cast<InstructionSentence &>(*sentence);
-                        auto &operandContainerVector = instructionSentence.operandContainerVector;
-                        
-                        for (auto it = operandContainerVector.begin(); it != operandContainerVector.end(); ++it) {
-                            instructionOperandImplicitSizeSetter(get<0>(*it));
-                            instructionOperandSizeChecker(*it);
-                        }
-
-                        dispVector[i] = getInstructionBytePresentSize(instructionSentence.compute());
-                    } else {
-                        vector<Label> labelDependVector;
-                        for (auto it = rawOperandContainerDependVector.begin(); it != rawOperandContainerDependVector.end(); ++it) {
-                            if (std::find(labelDependVector.begin(), labelDependVector.end(), *get<0>(**it).rawNum.label) == labelDependVector.end())
-                                labelDependVector.push_back(*get<0>(**it).rawNum.label);
-                        }
-
-                        vector<Integer::Size> operandSizeDependVector(rawOperandContainerDependVector.size(), Integer::Size::S_8);
-
-                        bool sizeComputed = false;
-                        while (true) {
-                            RawInstructionSentence innerRawInstructionSentence = rawInstructionSentence;
-                            auto &innerRawOperandContainerVector = innerRawInstructionSentence.operandContainerVector;
-
-                            for (auto it = innerRawOperandContainerVector.begin(); it != innerRawOperandContainerVector.end(); ++it) {
-                                if (get<0>(*it).rawNum.isNotFinal) {
-                                    auto currLabelDependIt = std::find(labelDependVector.begin(),
-                                                                       labelDependVector.end(),
-                                                                       *get<0>(*it).rawNum.label);
-                                    auto currSize = operandSizeDependVector[currLabelDependIt - labelDependVector.begin()];
-
-                                    if (get<0>(*it).mask.match(MEM))
-                                        get<0>(*it).rawNum.num = Integer::getMaxValSigned(currSize);
-                                    else
-                                        get<0>(*it).rawNum.num = Integer::getMaxValAny(currSize);
-                                    get<0>(*it).rawNum.isNotFinal = false;
-                                }                            
-                            }
-
-                            shared_ptr<Sentence> innerSentence = constructSentenceFromRaw(innerRawInstructionSentence, getLinkVectorFromRawSentence(sourceRawInstructionSentence));
-                            InstructionSentence &innerInstructionSentence = static_cast<InstructionSentence &>(*innerSentence);
-                            auto &innerOperandContainerVector = innerInstructionSentence.operandContainerVector;
-
-                            for (auto it = innerOperandContainerVector.begin(); it != innerOperandContainerVector.end(); ++it) {
-                                instructionOperandImplicitSizeSetter(get<0>(*it));
-                                instructionOperandSizeChecker(*it);
-                            }
-
-                            auto innerDispsSegmentContainerVector = dispsSegmentContainerVector;
-                            auto innerDispsSegmentContainerIt = std::find_if(innerDispsSegmentContainerVector.begin(),
-                                                                             innerDispsSegmentContainerVector.end(),
-                                                                             DispsSegmentFinder(segIt->segName));
-                            auto &innerDispVector = innerDispsSegmentContainerIt->dispVector;
-                            
-                            bool sizeSuites = false;
-                            if (!findSuitableDefinitions(innerInstructionSentence).empty()) {
-                                innerDispVector[i] = getInstructionBytePresentSize(innerInstructionSentence.compute());
-
-                                for (auto it = labelDependVector.begin(); it != labelDependVector.end(); ++it) {
-                                    auto innerRawSegIt = std::find_if(rawSentencesSegmentContainerVector.begin(),
-                                                                      rawSentencesSegmentContainerVector.end(),
-                                                                      RawSentencesSegmentFinder(it->segName));
-
-                                    innerDispsSegmentContainerVector = recursiveSizeComputer(innerDispsSegmentContainerVector,
-                                                                                             innerRawSegIt);
-                                }
-
-                                sizeSuites = true;
-                                for (auto it = rawOperandContainerDependVector.begin(); it != rawOperandContainerDependVector.end(); ++it) {
-                                    auto innerSegIt = std::find_if(innerDispsSegmentContainerVector.begin(),
-                                                                   innerDispsSegmentContainerVector.end(),
-                                                                   DispsSegmentFinder(get<0>(**it).rawNum.label->segName));
-                                    Integer curInnerLabelDisp = computeDisp(innerSegIt->dispVector.begin(),
-                                                                              innerSegIt->dispVector.begin() + get<0>(**it).rawNum.label->ptr);
-                                    Integer curInnerOpNum = get<0>(**it).rawNum.num + curInnerLabelDisp;
-
-                                    Integer::Size curInnerOpSize = get<0>(**it).mask.match(MEM) ? *curInnerOpNum.sizeSigned() : curInnerOpNum.sizeAny();
-
-                                    Integer::Size curInnerNeedOpSize = operandSizeDependVector[it - rawOperandContainerDependVector.begin()];
-
-                                    if (curInnerOpSize > curInnerNeedOpSize) {
-                                        sizeSuites = false;
-                                        break;
-                                    }
-                                }
-                            }
-
-                            if (sizeSuites) {
-                                dispsSegmentContainerVector = innerDispsSegmentContainerVector;
-                                sizeComputed = true;
-                                break;
-                            }
-
-                            if ((size_t)std::count(operandSizeDependVector.begin(), operandSizeDependVector.end(), Integer::Size::S_64) == operandSizeDependVector.size())
-                                break;
-
-                            auto it = operandSizeDependVector.end() - 1;
-                            do {
-                                if (*it != Integer::Size::S_64) {
-                                    *it = Integer::nextSize(*it);
-                                    break;
-                                } else {
-                                    *it = Integer::Size::S_8;
-                                }
-                            } while (it != operandSizeDependVector.begin());
-                        }
-
-                        if (!sizeComputed)
-                            throw CompileError("incorrect instruction or operand", rawInstructionSentence.pos());
-                    }
+                if (spanDependentSentence.operandIndexVector.empty()) {
+                    SpanDependentSentence fixedSentence = {segIndex, i, {}, {}};
+                    sizeVectors[segIndex][i] = sizeSpanDependentSentence(fixedSentence);
+                } else {
+                    sizeVectors[segIndex][i] = sizeSpanDependentSentence(spanDependentSentence);
+                    spanDependentIndexVectors[segIndex][i] = spanDependentSentenceVector.size();
+                    spanDependentSentenceVector.push_back(std::move(spanDependentSentence));
                 }
             } else {
-                RawDataSentence rawDataSentence = static_cast<RawDataSentence &>(*sentencePtr);
-                auto &rawOperandContainerVector = rawDataSentence.operandContainerVector;
+                const RawDataSentence &rawDataSentence = rawSentence.get<RawDataSentence>();
 
                 size_t mult;
                 switch (rawDataSentence.dataIdentifier) {
@@ -624,30 +601,68 @@ vector<SentencesSegment> constructSentences(const vector<RawSentencesSegment> &r
                     break;
                 }
 
-                dispVector[i] = mult * rawOperandContainerVector.size();
+                sizeVectors[segIndex][i] = mult * rawDataSentence.operandContainerVector.size();
             }
         }
+    }
 
-        return dispsSegmentContainerVector;
-    };
+    for (auto it = sizeVectors.begin(); it != sizeVectors.end(); ++it)
+        offsetTables.push_back(OffsetTable(*it));
+
+    bool isChanged = true;
+    for (size_t iteration = 0; isChanged; ++iteration) {
+        TraceSpan span("relaxation", "relaxation");
+        span.setArg("iteration", iteration);
+        span.setArg("spanDependentSentences", spanDependentSentenceVector.size());
+        size_t resizedCount = 0;
+        isChanged = false;
+
+        for (auto it = spanDependentSentenceVector.begin(); it != spanDependentSentenceVector.end(); ++it) {
+            bool isGrown = false;
+            for (size_t k = 0; k < it->operandIndexVector.size(); ++k) {
+                Integer::Size requiredSize = getRequiredOperandSize(*it, k);
+
+                if (requiredSize > it->operandSizeVector[k]) {
+                    it->operandSizeVector[k] = requiredSize;
+                    isGrown = true;
+                }
+            }
+
+            if (isGrown) {
+                size_t size = sizeSpanDependentSentence(*it);
+
+                if (size != offsetTables[it->segIndex].size(it->index)) {
+                    offsetTables[it->segIndex].setSize(it->index, size);
+                    ++resizedCount;
+                    isChanged = true;
+                }
+            }
+        }
 
-    vector<DispsSegmentContainer> dispsSegmentContainerVector;
-    for (auto it = rawSentencesSegmentContainerVector.begin(); it != rawSentencesSegmentContainerVector.end(); ++it)
-        dispsSegmentContainerVector.push_back({it->segName, vector<optional<size_t>>(it->rawSentences.size(), nullopt)});
+        span.setArg("resized", resizedCount);
 
-    for (auto it = rawSentencesSegmentContainerVector.begin(); it != rawSentencesSegmentContainerVector.end(); ++it)
-        dispsSegmentContainerVector = recursiveSizeComputer(dispsSegmentContainerVector, it);
+        Stats *stats = Stats::current();
+        if (stats) {
+            ++stats->relaxationPasses;
+            stats->jumpSizeChanges += resizedCount;
+        }
+    }
 
     vector<SentencesSegment> sentencesSegmentContainer;
 
     for (auto it = rawSentencesSegmentContainerVector.begin(); it != rawSentencesSegmentContainerVector.end(); ++it) {
-        vector<shared_ptr<Sentence>> sentenceVector;
+        TraceSpan span("construct", it->segName, "segment");
+        ArenaVector<Sentence> sentenceVector;
         const string &segName = it->segName;
-        const vector<shared_ptr<RawSentence>> &rawSentenceVector = it->rawSentences;
+        const ArenaVector<RawSentence> &rawSentenceVector = it->rawSentences;
+        size_t segIndex = it - rawSentencesSegmentContainerVector.begin();
+        sentenceVector.reserve(rawSentenceVector.size());
 
         for (auto jt = rawSentenceVector.begin(); jt != rawSentenceVector.end(); ++jt) {
-            if (typeid(**jt) == typeid(RawInstructionSentence)) {
-                const RawInstructionSentence &sourceRawInstructionSentence = static_cast<const RawInstructionSentence &>(**jt);
+            size_t i = jt - rawSentenceVector.begin();
+
+            if (jt->is<RawInstructionSentence>()) {
+                const RawInstructionSentence &sourceRawInstructionSentence = jt->get<RawInstructionSentence>();
                 RawInstructionSentence rawInstructionSentence = sourceRawInstructionSentence;
                 auto &rawOperandContainerVector = rawInstructionSentence.operandContainerVector;
 
@@ -656,66 +671,64 @@ vector<SentencesSegment> constructSentences(const vector<RawSentencesSegment> &r
                     RawInstructionSentence::Operand &rawOperand = get<0>(rawOperandContainer);
 
                     if (rawOperand.rawNum.isNotFinal) {
-                        auto labelSegIt = std::find_if(dispsSegmentContainerVector.begin(),
-                                                       dispsSegmentContainerVector.end(),
-                                                       DispsSegmentFinder(rawOperand.rawNum.label->segName));
-                        Integer labelVal = computeDisp(labelSegIt->dispVector.begin(),
-                                                         labelSegIt->dispVector.begin() + rawOperand.rawNum.label->ptr);
-
-                        rawOperand.rawNum.num += labelVal;
-
-                        if (rawOperand.mask.match(REL)) {
-                            rawOperand.rawNum.num -= computeDisp(labelSegIt->dispVector.begin(),
-                                                                 labelSegIt->dispVector.begin() + (jt - rawSentenceVector.begin()) + 1);
-                        }
+                        if (rawOperand.mask.match(REL) && (!isRelocatable) && (rawOperand.rawNum.label->segName != segName))
+                            throw CompileError("relative jump to another segment requires relocatable output", get<1>(rawOperandContainer));
+
+                        rawOperand.rawNum.num += Integer(getLabelOffset(*rawOperand.rawNum.label));
+
+                        if (rawOperand.mask.match(REL))
+                            rawOperand.rawNum.num -= Integer(getSentenceEndOffset(segIndex, i));
                     }
                 }
 
-                shared_ptr<Sentence> sentence = constructSentenceFromRaw(rawInstructionSentence, getLinkVectorFromRawSentence(sourceRawInstructionSentence));
-
-                InstructionSentence &instructionSentence = static_cast<InstructionSentence &>(*sentence);
+                InstructionSentence instructionSentence = constructInstructionSentenceFromRaw(rawInstructionSentence, getLinkVectorFromRawSentence(sourceRawInstructionSentence));
                 auto &operandContainerVector = instructionSentence.operandContainerVector;
 
+                size_t spanDependentIndex = spanDependentIndexVectors[segIndex][i];
+                if (spanDependentIndex != notSpanDependent) {
+                    const SpanDependentSentence &spanDependentSentence = spanDependentSentenceVector[spanDependentIndex];
+
+                    for (size_t k = 0; k < spanDependentSentence.operandIndexVector.size(); ++k) {
+                        auto &operand = get<0>(operandContainerVector[spanDependentSentence.operandIndexVector[k]]);
+
+                        if (operand.mask.match(REL) && (!operand.mask.matchAny(S_ANY)))
+                            operand.mask |= Mask::operandSizeFromIntegerSize(spanDependentSentence.operandSizeVector[k]);
+                    }
+                }
+
                 for (auto kt = operandContainerVector.begin(); kt != operandContainerVector.end(); ++kt) {
                     instructionOperandImplicitSizeSetter(get<0>(*kt));
                     instructionOperandSizeChecker(*kt);
                 }
 
-                sentenceVector.push_back(sentence);
+                sentenceVector.emplace_back(std::move(instructionSentence));
             } else {
-                RawDataSentence rawDataSentence = static_cast<const RawDataSentence &>(**jt);
+                RawDataSentence rawDataSentence = jt->get<RawDataSentence>();
                 auto &rawOperandContainerVector = rawDataSentence.operandContainerVector;
 
                 for (auto kt = rawOperandContainerVector.begin(); kt != rawOperandContainerVector.end(); ++kt) {
                     RawDataSentence::OperandContainer &rawOperandContainer = *kt;
                     RawDataSentence::Operand &rawOperand = get<0>(rawOperandContainer);
 
-                    if (rawOperand.label) {
-                        auto labelSegIt = std::find_if(dispsSegmentContainerVector.begin(),
-                                                       dispsSegmentContainerVector.end(),
-                                                       DispsSegmentFinder(rawOperand.label->segName));
-
-                        Integer labelVal = computeDisp(labelSegIt->dispVector.begin(),
-                                                         labelSegIt->dispVector.begin() + rawOperand.label->ptr);
-                    
-                        rawOperand.num += labelVal;
-                    }
+                    if (rawOperand.label)
+                        rawOperand.num += Integer(getLabelOffset(*rawOperand.label));
                 }
 
-                shared_ptr<Sentence> sentence = constructSentenceFromRaw(rawDataSentence);
-
-                DataSentence &dataSentence = static_cast<DataSentence &>(*sentence);
+                DataSentence dataSentence = constructDataSentenceFromRaw(rawDataSentence);
                 auto &operandContainerVector = dataSentence.operandContainerVector;
 
                 for (auto kt = operandContainerVector.begin(); kt != operandContainerVector.end(); ++kt)
                     dataOperandSizeChecker(*kt, dataSentence.dataIdentifier);
 
-                sentenceVector.push_back(sentence);
+                sentenceVector.emplace_back(std::move(dataSentence));
             }
         }
 
-        sentencesSegmentContainer.push_back({segName, sentenceVector});
+        sentencesSegmentContainer.push_back({segName, std::move(sentenceVector), OffsetTable()});
     }
 
+    for (size_t segIndex = 0; segIndex < sentencesSegmentContainer.size(); ++segIndex)
+        sentencesSegmentContainer[segIndex].offsets = std::move(offsetTables[segIndex]);
+
     return sentencesSegmentContainer;
 }
@@ -7,13 +7,13 @@
 #include "CodePosition.h"
 #include "Instruction.h"
 #include "PseudoSentence.h"
+#include "Arena.h"
+#include "Variant.h"
+#include "OffsetTable.h"
 
-class Sentence {
+class SentenceBase {
 public:
-    virtual vector<vector<uchar>> compute() const = 0;
-    virtual tuple<string, vector<string>> present() const = 0;
-    
-    Sentence(CodePosition pos, Assume assume) :
+    inline SentenceBase(CodePosition pos, Assume assume) :
         pos(pos),
         assume(assume)
     {}
@@ -22,7 +22,15 @@ public:
     Assume assume;
 };
 
-class InstructionSentence: public Sentence {
+class Relocation {
+public:
+    size_t offset;
+    Integer::Size size;
+    string segName;
+    bool isRelative;
+};
+
+class InstructionSentence : public SentenceBase {
 public:
     enum class SegmentPrefix {
         ES,
@@ -45,50 +53,102 @@ public:
     typedef InstructionNS::Instruction Instruction;
     typedef tuple<Operand, CodePosition> OperandContainer;
 
-    inline InstructionSentence(CodePosition pos, Assume assume, optional<SegmentPrefix> segmentPrefix, Instruction instruction, vector<OperandContainer> operandContainerVector) :
-        Sentence(pos, assume),
+    inline InstructionSentence(CodePosition pos, Assume assume, optional<SegmentPrefix> segmentPrefix, Instruction instruction, ArenaVector<OperandContainer> operandContainerVector) :
+        SentenceBase(pos, assume),
         segmentPrefix(segmentPrefix),
         instruction(instruction),
-        operandContainerVector(operandContainerVector)
+        operandContainerVector(std::move(operandContainerVector))
     {}
 
-    virtual vector<vector<uchar>> compute() const override;
-    virtual tuple<string, vector<string>> present() const override;
+    void encode(ByteEmitter &emitter, vector<Relocation> *relocationVector = nullptr) const;
+    size_t encodedSize() const;
+    tuple<string, vector<string>> present() const;
 
     optional<SegmentPrefix> segmentPrefix;
     Instruction instruction;
-    vector<OperandContainer> operandContainerVector;
+    ArenaVector<OperandContainer> operandContainerVector;
 
     static const map<SegmentPrefix, OperandMask::Mask> prefixToSegRegMap;
 };
 
-class DataSentence : public Sentence {
+class DataSentence : public SentenceBase {
 public:
-    typedef Integer Operand;
+    class Operand {
+    public:
+        Integer num;
+        optional<string> segName;
+    };
+
     typedef tuple<Operand, CodePosition> OperandContainer;
     typedef InstructionNS::DataIdentifier DataIdentifier;
 
-    inline DataSentence(CodePosition pos, Assume assume, DataIdentifier dataIdentifier, vector<OperandContainer> operandContainerVector) :
-        Sentence(pos, assume),
+    inline DataSentence(CodePosition pos, Assume assume, DataIdentifier dataIdentifier, ArenaVector<OperandContainer> operandContainerVector) :
+        SentenceBase(pos, assume),
         dataIdentifier(dataIdentifier),
-        operandContainerVector(operandContainerVector)
+        operandContainerVector(std::move(operandContainerVector))
     {}
 
-    virtual vector<vector<uchar>> compute() const override;
-    virtual tuple<string, vector<string>> present() const override;
+    void encode(ByteEmitter &emitter, vector<Relocation> *relocationVector = nullptr) const;
+    size_t encodedSize() const;
+    tuple<string, vector<string>> present() const;
 
     DataIdentifier dataIdentifier;
-    vector<OperandContainer> operandContainerVector;
+    ArenaVector<OperandContainer> operandContainerVector;
+private:
+    Integer::Size operandSize() const;
+};
+
+class Sentence : public Variant<InstructionSentence, DataSentence> {
+public:
+    inline Sentence(InstructionSentence instructionSentence) :
+        Variant(std::move(instructionSentence))
+    {}
+
+    inline Sentence(DataSentence dataSentence) :
+        Variant(std::move(dataSentence))
+    {}
+
+    inline void encode(ByteEmitter &emitter, vector<Relocation> *relocationVector = nullptr) const {
+        visit([&](const auto &sentence) {
+            sentence.encode(emitter, relocationVector);
+        });
+    }
+
+    inline size_t encodedSize() const {
+        return visit([](const auto &sentence) {
+            return sentence.encodedSize();
+        });
+    }
+
+    inline tuple<string, vector<string>> present() const {
+        return visit([](const auto &sentence) {
+            return sentence.present();
+        });
+    }
+
+    inline const CodePosition &pos() const {
+        return base().pos;
+    }
+
+    inline const Assume &assume() const {
+        return base().assume;
+    }
+private:
+    inline const SentenceBase &base() const {
+        return visit([](const SentenceBase &sentence) -> const SentenceBase & {
+            return sentence;
+        });
+    }
 };
 
 struct SentencesSegment {
     string segName;
-    vector<shared_ptr<Sentence>> sentences;
+    ArenaVector<Sentence> sentences;
+    OffsetTable offsets;
 };
 
-class RawSentence;
 struct RawSentencesSegment;
 
-vector<SentencesSegment> constructSentences(const vector<RawSentencesSegment> &rawSentencesSegmentContainerVector);
+vector<SentencesSegment> constructSentences(const vector<RawSentencesSegment> &rawSentencesSegmentContainerVector, size_t origin = 0, bool isRelocatable = false);
 
 #endif
@@ -0,0 +1,432 @@
+#include "Server.h"
+
+#include "Assembler.h"
+#include "Exception.h"
+#include "Diagnostics.h"
+#include "ThreadPool.h"
+#include <sstream>
+#include <thread>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+void writeAssembleResult(FILE *output, const AssembleResult &result) {
+    static const char hexDigits[] = "0123456789ABCDEF";
+
+    std::ostringstream response;
+    response << "RESULT " << (result.isSucceeded ? "OK" : "FAILED") << "\n";
+
+    for (auto it = result.segments.begin(); it != result.segments.end(); ++it) {
+        string hex;
+        hex.reserve(it->bytes.size() * 2);
+        for (auto jt = it->bytes.begin(); jt != it->bytes.end(); ++jt) {
+            hex += hexDigits[*jt >> 4];
+            hex += hexDigits[*jt & 0xF];
+        }
+
+        response << "SEGMENT " << it->name << " " << it->bytes.size() << " " << hex << "\n";
+
+        for (auto jt = it->relocations.begin(); jt != it->relocations.end(); ++jt) {
+            response << "RELOCATION " << it->name << " " << jt->offset << " " << Integer::getByteCount(jt->size) << " "
+                     << jt->segName << " " << (jt->isRelative ? "REL" : "ABS") << "\n";
+        }
+    }
+
+    for (auto it = result.symbols.begin(); it != result.symbols.end(); ++it)
+        response << "SYMBOL " << it->name << " " << it->segName << " " << it->offset << "\n";
+
+    if (result.entryLabel)
+        response << "ENTRY " << *result.entryLabel << "\n";
+
+    for (auto it = result.diagnostics.begin(); it != result.diagnostics.end(); ++it) {
+        if (it->pos)
+            response << "DIAGNOSTIC " << it->pos->row << " " << it->pos->column << " " << it->pos->length << " " << it->message << "\n";
+        else
+            response << "DIAGNOSTIC 0 0 0 " << it->message << "\n";
+    }
+
+    response << "END\n";
+
+    string responseString = response.str();
+    fwrite(responseString.data(), 1, responseString.size(), output);
+    fflush(output);
+}
+
+void writeRequestError(FILE *output, const string &text) {
+    AssembleResult result;
+    result.diagnostics.push_back({text, nullopt});
+
+    writeAssembleResult(output, result);
+}
+
+constexpr size_t maxSourceLength = 64 * 1024 * 1024;
+constexpr size_t minWorkerCount = 4;
+constexpr time_t requestTimeoutSeconds = 30;
+
+namespace {
+
+constexpr char wakeByte = 'W';
+constexpr char shutdownByte = 'S';
+
+int wakePipe[2] = {-1, -1};
+
+void wakeAcceptor(char byte) {
+    ssize_t count = write(wakePipe[1], &byte, 1);
+    (void)count;
+}
+
+void requestShutdown(int) {
+    wakeAcceptor(shutdownByte);
+}
+
+bool readRequestLine(FILE *input, string &line) {
+    char *buffer = nullptr;
+    size_t bufferCapacity = 0;
+    ssize_t length = getline(&buffer, &bufferCapacity, input);
+
+    if (length > 0)
+        line.assign(buffer, length);
+    free(buffer);
+
+    return length > 0;
+}
+
+bool serveRequest(FILE *input, FILE *output, TokenCache &tokenCache) {
+    string line;
+    if (!readRequestLine(input, line))
+        return false;
+
+    std::istringstream request(line);
+    string command;
+    request >> command;
+
+    if (command.empty())
+        return true;
+    else if (command == "QUIT")
+        return false;
+    else if (command != "ASSEMBLE") {
+        writeRequestError(output, "unknown request \'" + command + "\'");
+        return true;
+    }
+
+    string lengthParam;
+    if (!(request >> lengthParam)) {
+        writeRequestError(output, "ASSEMBLE requires a source length");
+        return true;
+    }
+
+    size_t sourceLength = 0;
+    size_t length = 0;
+    if (std::isdigit(static_cast<uchar>(lengthParam[0]))) {
+        try {
+            sourceLength = std::stoull(lengthParam, &length);
+        } catch (std::exception &) {
+            length = 0;
+        }
+    }
+
+    if ((length != lengthParam.size()) || (sourceLength > maxSourceLength)) {
+        writeRequestError(output, "invalid source length \'" + lengthParam + "\', expected at most " + std::to_string(maxSourceLength) + " bytes");
+        return true;
+    }
+
+    AssembleOptions options;
+    options.tokenCache = &tokenCache;
+
+    optional<string> requestError;
+    string param;
+    while (request >> param) {
+        if (param == "ARCH=16")
+            options.arch = Compiler::Arch::X86_16;
+        else if (param == "ARCH=32")
+            options.arch = Compiler::Arch::X86_32;
+        else if (param.compare(0, 4, "ORG=") == 0) {
+            size_t length = 0;
+            try {
+                options.origin = std::stoul(param.substr(4), &length, 0);
+            } catch (std::exception &) {
+            }
+
+            if (length != param.size() - 4)
+                requestError = "invalid origin \'" + param.substr(4) + "\'";
+        } else
+            requestError = "unknown parameter \'" + param + "\'";
+    }
+
+    string source(sourceLength, '\0');
+    if (fread(&source[0], 1, sourceLength, input) != sourceLength)
+        return false;
+
+    try {
+        if (requestError)
+            writeRequestError(output, *requestError);
+        else
+            writeAssembleResult(output, assemble(source.data(), source.size(), options));
+    } catch (std::exception &e) {
+        writeRequestError(output, e.what());
+    }
+
+    return true;
+}
+
+class Connection {
+public:
+    int fd;
+    FILE *input;
+    FILE *output;
+};
+
+optional<Connection> openConnection(int fd) {
+    FILE *input = fdopen(fd, "r");
+    if (!input) {
+        close(fd);
+        return nullopt;
+    }
+
+    int outputFd = dup(fd);
+    FILE *output = (outputFd >= 0) ? fdopen(outputFd, "w") : nullptr;
+    if (!output) {
+        if (outputFd >= 0)
+            close(outputFd);
+        fclose(input);
+        return nullopt;
+    }
+
+    // Input stays unbuffered so that a readable descriptor is the only sign of a pending request.
+    setvbuf(input, nullptr, _IONBF, 0);
+
+    timeval requestTimeout = {requestTimeoutSeconds, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &requestTimeout, sizeof(requestTimeout));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &requestTimeout, sizeof(requestTimeout));
+
+    return Connection{fd, input, output};
+}
+
+void closeConnection(const Connection &connection) {
+    fclose(connection.output);
+    fclose(connection.input);
+}
+
+bool serveConnectionRequest(const Connection &connection, TokenCache &tokenCache) {
+    try {
+        return serveRequest(connection.input, connection.output, tokenCache);
+    } catch (std::exception &e) {
+        DiagnosticStreams::err() << "Error: " << e.what() << endl;
+        writeRequestError(connection.output, e.what());
+    } catch (...) {
+        DiagnosticStreams::err() << "Error: unknown exception while serving a request" << endl;
+        writeRequestError(connection.output, "internal error");
+    }
+
+    return false;
+}
+
+class ConnectionDispatcher {
+public:
+    inline ConnectionDispatcher() :
+        isClosed(false)
+    {}
+
+    void park(const Connection &connection) {
+        std::lock_guard<std::mutex> lock(mutex);
+        activeFds.erase(connection.fd);
+
+        if (isClosed) {
+            closeConnection(connection);
+            return;
+        }
+
+        parkedConnections.insert({connection.fd, connection});
+        wakeAcceptor(wakeByte);
+    }
+
+    void finish(const Connection &connection) {
+        std::lock_guard<std::mutex> lock(mutex);
+        activeFds.erase(connection.fd);
+        closeConnection(connection);
+    }
+
+    void appendParkedFds(vector<pollfd> &pollFds) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto it = parkedConnections.begin(); it != parkedConnections.end(); ++it)
+            pollFds.push_back({it->first, POLLIN, 0});
+    }
+
+    void dispatch(int fd) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = parkedConnections.find(fd);
+        if (it == parkedConnections.end())
+            return;
+
+        readyConnections.push_back(it->second);
+        parkedConnections.erase(it);
+        connectionReady.notify_one();
+    }
+
+    optional<Connection> pop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        connectionReady.wait(lock, [this] { return isClosed || (!readyConnections.empty()); });
+        if (readyConnections.empty())
+            return nullopt;
+
+        Connection connection = readyConnections.front();
+        readyConnections.pop_front();
+        activeFds.insert(connection.fd);
+
+        return connection;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        isClosed = true;
+
+        for (auto it = parkedConnections.begin(); it != parkedConnections.end(); ++it)
+            closeConnection(it->second);
+        parkedConnections.clear();
+
+        for (auto it = readyConnections.begin(); it != readyConnections.end(); ++it)
+            closeConnection(*it);
+        readyConnections.clear();
+
+        for (auto it = activeFds.begin(); it != activeFds.end(); ++it)
+            shutdown(*it, SHUT_RD);
+
+        connectionReady.notify_all();
+    }
+private:
+    std::mutex mutex;
+    std::condition_variable connectionReady;
+    map<int, Connection> parkedConnections;
+    std::deque<Connection> readyConnections;
+    set<int> activeFds;
+    bool isClosed;
+};
+
+}
+
+void serveConnection(FILE *input, FILE *output, TokenCache &tokenCache) {
+    while (serveRequest(input, output, tokenCache));
+}
+
+bool serve(const optional<string> &socketPath) {
+    TokenCache tokenCache;
+
+    if (!socketPath) {
+        serveConnection(stdin, stdout, tokenCache);
+        return true;
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (socketPath->size() >= sizeof(address.sun_path))
+        throw Exception(string("Socket path \'") + *socketPath + "\' is too long");
+    socketPath->copy(address.sun_path, socketPath->size());
+
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0)
+        throw Exception("Can not create socket");
+
+    unlink(socketPath->c_str());
+
+    if ((bind(listenFd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0) || (listen(listenFd, 16) < 0)) {
+        close(listenFd);
+        throw Exception(string("Can not listen on \'") + *socketPath + "\'");
+    }
+
+    if (pipe(wakePipe) < 0) {
+        close(listenFd);
+        unlink(socketPath->c_str());
+        throw Exception("Can not create wake pipe");
+    }
+    fcntl(wakePipe[1], F_SETFL, O_NONBLOCK);
+
+    struct sigaction shutdownAction = {};
+    shutdownAction.sa_handler = requestShutdown;
+    shutdownAction.sa_flags = SA_RESTART;
+    struct sigaction previousIntAction;
+    struct sigaction previousTermAction;
+    sigaction(SIGINT, &shutdownAction, &previousIntAction);
+    sigaction(SIGTERM, &shutdownAction, &previousTermAction);
+
+    size_t workerCount = std::max(ThreadPool::defaultThreadCount(), minWorkerCount);
+    ThreadPool workerPool(workerCount + 1);
+    ConnectionDispatcher dispatcher;
+    bool isSucceeded = true;
+
+    workerPool.parallelFor(workerCount + 1, [&](size_t index) {
+        if (index != 0) {
+            optional<Connection> connection;
+            while ((connection = dispatcher.pop())) {
+                if (serveConnectionRequest(*connection, tokenCache))
+                    dispatcher.park(*connection);
+                else
+                    dispatcher.finish(*connection);
+            }
+
+            return;
+        }
+
+        vector<pollfd> pollFds;
+        bool isShuttingDown = false;
+        while (!isShuttingDown) {
+            pollFds.assign({{listenFd, POLLIN, 0}, {wakePipe[0], POLLIN, 0}});
+            dispatcher.appendParkedFds(pollFds);
+
+            if (poll(pollFds.data(), pollFds.size(), -1) < 0) {
+                if (errno == EINTR)
+                    continue;
+                DiagnosticStreams::err() << "Error: poll failed, " << strerror(errno) << endl;
+                isSucceeded = false;
+                break;
+            }
+
+            if (pollFds[1].revents != 0) {
+                char wakeBytes[64];
+                ssize_t count = read(wakePipe[0], wakeBytes, sizeof(wakeBytes));
+                isShuttingDown = (count > 0) && (std::find(wakeBytes, wakeBytes + count, shutdownByte) != wakeBytes + count);
+            }
+
+            for (auto it = pollFds.begin() + 2; it != pollFds.end(); ++it) {
+                if (it->revents != 0)
+                    dispatcher.dispatch(it->fd);
+            }
+
+            if (pollFds[0].revents != 0) {
+                int connectionFd = accept(listenFd, nullptr, nullptr);
+                if (connectionFd < 0) {
+                    if ((errno != EINTR) && (errno != ECONNABORTED))
+                        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                    continue;
+                }
+
+                optional<Connection> connection = openConnection(connectionFd);
+                if (connection)
+                    dispatcher.park(*connection);
+            }
+        }
+
+        dispatcher.close();
+    });
+
+    sigaction(SIGINT, &previousIntAction, nullptr);
+    sigaction(SIGTERM, &previousTermAction, nullptr);
+    close(wakePipe[0]);
+    close(wakePipe[1]);
+    close(listenFd);
+    unlink(socketPath->c_str());
+
+    return isSucceeded;
+}
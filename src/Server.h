@@ -0,0 +1,11 @@
+#ifndef _SERVER_H_
+#define _SERVER_H_
+
+#include "Global.h"
+#include "TokenCache.h"
+#include <cstdio>
+
+void serveConnection(FILE *input, FILE *output, TokenCache &tokenCache);
+bool serve(const optional<string> &socketPath);
+
+#endif
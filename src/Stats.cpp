@@ -0,0 +1,19 @@
+#include "Stats.h"
+
+thread_local Stats *Stats::currentStats = nullptr;
+
+Stats *Stats::current() {
+    return currentStats;
+}
+
+void Stats::merge(const Stats &other) {
+    definitionLookups += other.definitionLookups;
+    definitionsProbed += other.definitionsProbed;
+    definitionRankings += other.definitionRankings;
+    definitionsRanked += other.definitionsRanked;
+    relaxationPasses += other.relaxationPasses;
+    jumpSizeChanges += other.jumpSizeChanges;
+    equEvaluations += other.equEvaluations;
+    excludedTokens.insert(excludedTokens.end(), other.excludedTokens.begin(), other.excludedTokens.end());
+    segmentBytes.insert(segmentBytes.end(), other.segmentBytes.begin(), other.segmentBytes.end());
+}
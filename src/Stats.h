@@ -0,0 +1,33 @@
+#ifndef _STATS_H_
+#define _STATS_H_
+
+#include "Global.h"
+#include "ScopedCurrent.h"
+
+class Stats {
+public:
+    size_t definitionLookups = 0;
+    size_t definitionsProbed = 0;
+    size_t definitionRankings = 0;
+    size_t definitionsRanked = 0;
+    size_t relaxationPasses = 0;
+    size_t jumpSizeChanges = 0;
+    size_t equEvaluations = 0;
+    vector<tuple<string, size_t>> excludedTokens;
+    vector<tuple<string, size_t>> segmentBytes;
+
+    void merge(const Stats &other);
+
+    static Stats *current();
+
+    class Scope : public ScopedCurrent<Stats *> {
+    public:
+        inline Scope(Stats *stats) :
+            ScopedCurrent(currentStats, stats)
+        {}
+    };
+private:
+    static thread_local Stats *currentStats;
+};
+
+#endif
@@ -0,0 +1,92 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(size_t threadCount) :
+    currentTask(nullptr),
+    taskCount(0),
+    nextTask(0),
+    finishedTaskCount(0),
+    generation(0),
+    isStopping(false)
+{
+    for (size_t i = 1; i < threadCount; ++i)
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isStopping = true;
+    }
+
+    workAvailable.notify_all();
+
+    for (auto it = workers.begin(); it != workers.end(); ++it)
+        it->join();
+}
+
+void ThreadPool::parallelFor(size_t taskCount, const function<void(size_t)> &task) {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    currentTask = &task;
+    this->taskCount = taskCount;
+    nextTask = 0;
+    finishedTaskCount = 0;
+    ++generation;
+
+    workAvailable.notify_all();
+
+    runTasks(lock);
+    workFinished.wait(lock, [this] { return finishedTaskCount == this->taskCount; });
+
+    currentTask = nullptr;
+    std::exception_ptr exception = taskException;
+    taskException = nullptr;
+
+    lock.unlock();
+
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
+size_t ThreadPool::defaultThreadCount() {
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+void ThreadPool::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    size_t seenGeneration = generation;
+
+    while (true) {
+        workAvailable.wait(lock, [&] { return isStopping || (generation != seenGeneration); });
+
+        if (isStopping)
+            return;
+
+        seenGeneration = generation;
+        runTasks(lock);
+    }
+}
+
+void ThreadPool::runTasks(std::unique_lock<std::mutex> &lock) {
+    while (nextTask < taskCount) {
+        size_t index = nextTask++;
+        const function<void(size_t)> &task = *currentTask;
+
+        lock.unlock();
+
+        std::exception_ptr exception;
+        try {
+            task(index);
+        } catch (...) {
+            exception = std::current_exception();
+        }
+
+        lock.lock();
+
+        if (exception && (!taskException))
+            taskException = exception;
+
+        if (++finishedTaskCount == taskCount)
+            workFinished.notify_all();
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef _THREADPOOL_H_
+#define _THREADPOOL_H_
+
+#include "Global.h"
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+// Tasks of a parallelFor are handed out from one shared counter under the pool mutex,
+// there are no per-thread queues and no work stealing.
+class ThreadPool {
+public:
+    ThreadPool(size_t threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    inline size_t threadCount() const {
+        return workers.size() + 1;
+    }
+
+    void parallelFor(size_t taskCount, const function<void(size_t)> &task);
+
+    static size_t defaultThreadCount();
+private:
+    void workerLoop();
+    void runTasks(std::unique_lock<std::mutex> &lock);
+
+    vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable workFinished;
+    const function<void(size_t)> *currentTask;
+    size_t taskCount;
+    size_t nextTask;
+    size_t finishedTaskCount;
+    size_t generation;
+    bool isStopping;
+    std::exception_ptr taskException;
+};
+
+#endif
@@ -52,6 +52,7 @@ const string Token::sizeOperatorStr = "PTR";
 const string Token::equDirectiveStr = "EQU";
 const string Token::endDirectiveStr = "END";
 const string Token::assumeDirectiveStr = "ASSUME";
+const string Token::publicDirectiveStr = "PUBLIC";
 
 vector<TokenContainer> constructTokenContainerVector(vector<LexemeContainer> &lexemeContainerVector) {
     vector<TokenContainer> tokenContainerVector;
@@ -78,6 +79,8 @@ vector<TokenContainer> constructTokenContainerVector(vector<LexemeContainer> &le
             currentToken = Token(Token::Type::END_DIRECTIVE);
         else if (lexeme == Token::assumeDirectiveStr)
             currentToken = Token(Token::Type::ASSUME_DIRECTIVE);
+        else if (lexeme == Token::publicDirectiveStr)
+            currentToken = Token(Token::Type::PUBLIC_DIRECTIVE);
         else if (Token::memoryBracketMap.count(lexeme))
             currentToken = Token(Token::Type::MEMORY_BRACKET, Token::memoryBracketMap.find(lexeme)->second);
         else if (Token::mathSymbolMap.count(lexeme))
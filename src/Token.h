@@ -28,7 +28,8 @@ public:
         SIZE_OPERATOR,
         EQU_DIRECTIVE,
         END_DIRECTIVE,
-        ASSUME_DIRECTIVE
+        ASSUME_DIRECTIVE,
+        PUBLIC_DIRECTIVE
     };
 
     enum class MemoryBracket {
@@ -123,6 +124,7 @@ public:
     static const string equDirectiveStr;
     static const string endDirectiveStr;
     static const string assumeDirectiveStr;
+    static const string publicDirectiveStr;
 private:
     Type _type;
     UniquePtr<void> valueP;
@@ -0,0 +1,51 @@
+#include "TokenCache.h"
+
+TokenCache::TokenCache(size_t capacity) :
+    capacity(capacity),
+    hits(0),
+    misses(0)
+{}
+
+TokenCache::TokensPtr TokenCache::find(const string &source) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = entryIndex.find(source);
+    if (it == entryIndex.end()) {
+        ++misses;
+        return nullptr;
+    }
+
+    ++hits;
+    entries.splice(entries.begin(), entries, it->second);
+
+    return get<1>(*it->second);
+}
+
+void TokenCache::insert(const string &source, TokensPtr tokens) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = entryIndex.find(source);
+    if (it != entryIndex.end()) {
+        entries.splice(entries.begin(), entries, it->second);
+        get<1>(*it->second) = std::move(tokens);
+        return;
+    }
+
+    entries.emplace_front(source, std::move(tokens));
+    entryIndex[source] = entries.begin();
+
+    if (entries.size() > capacity) {
+        entryIndex.erase(get<0>(entries.back()));
+        entries.pop_back();
+    }
+}
+
+size_t TokenCache::hitCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+}
+
+size_t TokenCache::missCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+}
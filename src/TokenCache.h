@@ -0,0 +1,35 @@
+#ifndef _TOKENCACHE_H_
+#define _TOKENCACHE_H_
+
+#include "Global.h"
+#include "Token.h"
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+class TokenCache {
+public:
+    typedef std::shared_ptr<const vector<TokenContainer>> TokensPtr;
+
+    TokenCache(size_t capacity = 64);
+
+    TokenCache(const TokenCache &) = delete;
+    TokenCache &operator=(const TokenCache &) = delete;
+
+    TokensPtr find(const string &source);
+    void insert(const string &source, TokensPtr tokens);
+
+    size_t hitCount() const;
+    size_t missCount() const;
+private:
+    typedef std::list<tuple<string, TokensPtr>> EntryList;
+
+    const size_t capacity;
+    mutable std::mutex mutex;
+    EntryList entries;
+    std::unordered_map<string, EntryList::iterator> entryIndex;
+    size_t hits;
+    size_t misses;
+};
+
+#endif
@@ -0,0 +1,59 @@
+#include "Trace.h"
+
+#include <iomanip>
+
+thread_local Trace *Trace::currentTrace = nullptr;
+
+Trace::Trace() :
+    epoch(std::chrono::steady_clock::now())
+{}
+
+double Trace::now() const {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+void Trace::addEvent(string name, const char *category, double startTime, string args) {
+    _events.push_back({std::move(name), category, startTime, now() - startTime, std::move(args)});
+}
+
+string escapeJsonString(const string &str) {
+    string res;
+    res.reserve(str.size());
+
+    for (auto it = str.begin(); it != str.end(); ++it) {
+        if ((*it == '\"') || (*it == '\\')) {
+            res += '\\';
+            res += *it;
+        } else if ((uchar)*it < 0x20) {
+            const char hexDigits[] = "0123456789abcdef";
+            res += "\\u00";
+            res += hexDigits[(uchar)*it >> 4];
+            res += hexDigits[(uchar)*it & 0xF];
+        } else
+            res += *it;
+    }
+
+    return res;
+}
+
+void Trace::write(std::ostream &stream) const {
+    stream << std::fixed << std::setprecision(3);
+    stream << "{\"traceEvents\": [";
+
+    for (auto it = _events.begin(); it != _events.end(); ++it) {
+        stream << ((it == _events.begin()) ? "\n" : ",\n");
+        stream << "  {\"name\": \"" << escapeJsonString(it->name) << "\", "
+               << "\"cat\": \"" << it->category << "\", "
+               << "\"ph\": \"X\", "
+               << "\"ts\": " << it->startTime << ", "
+               << "\"dur\": " << it->duration << ", "
+               << "\"pid\": 1, \"tid\": 1, "
+               << "\"args\": {" << it->args << "}}";
+    }
+
+    stream << "\n], \"displayTimeUnit\": \"ms\"}\n";
+}
+
+Trace *Trace::current() {
+    return currentTrace;
+}
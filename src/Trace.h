@@ -0,0 +1,97 @@
+#ifndef _TRACE_H_
+#define _TRACE_H_
+
+#include "Global.h"
+#include "ScopedCurrent.h"
+#include <chrono>
+
+class Trace {
+public:
+    class Event {
+    public:
+        string name;
+        const char *category;
+        double startTime;
+        double duration;
+        string args;
+    };
+
+    Trace();
+
+    Trace(const Trace &) = delete;
+    Trace &operator=(const Trace &) = delete;
+
+    double now() const;
+    void addEvent(string name, const char *category, double startTime, string args);
+    void write(std::ostream &stream) const;
+
+    inline const vector<Event> &events() const {
+        return _events;
+    }
+
+    static Trace *current();
+
+    class Scope : public ScopedCurrent<Trace *> {
+    public:
+        inline Scope(Trace *trace) :
+            ScopedCurrent(currentTrace, trace)
+        {}
+    };
+private:
+    std::chrono::steady_clock::time_point epoch;
+    vector<Event> _events;
+
+    static thread_local Trace *currentTrace;
+};
+
+class TraceSpan {
+public:
+    inline TraceSpan(const char *name, const char *category) :
+        trace(Trace::current())
+    {
+        if (trace)
+            begin(name, category);
+    }
+
+    inline TraceSpan(const char *name, const string &detail, const char *category) :
+        trace(Trace::current())
+    {
+        if (trace)
+            begin(string(name) + " " + detail, category);
+    }
+
+    inline ~TraceSpan() {
+        if (trace)
+            trace->addEvent(std::move(name), category, startTime, std::move(args));
+    }
+
+    inline bool isEnabled() const {
+        return trace != nullptr;
+    }
+
+    inline void setArg(const char *key, size_t value) {
+        if (trace) {
+            args += (args.empty() ? "\"" : ", \"");
+            args += key;
+            args += "\": ";
+            args += std::to_string(value);
+        }
+    }
+private:
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+    inline void begin(string spanName, const char *spanCategory) {
+        name = std::move(spanName);
+        category = spanCategory;
+        startTime = trace->now();
+    }
+
+    Trace *trace;
+    string name;
+    const char *category;
+    double startTime;
+    string args;
+};
+
+#endif
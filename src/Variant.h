@@ -0,0 +1,147 @@
+#ifndef _VARIANT_H_
+#define _VARIANT_H_
+
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include <tuple>
+
+template<typename T, typename... Ts>
+struct VariantIndex;
+
+template<typename T, typename... Ts>
+struct VariantIndex<T, T, Ts...> : std::integral_constant<size_t, 0>
+{};
+
+template<typename T, typename U, typename... Ts>
+struct VariantIndex<T, U, Ts...> : std::integral_constant<size_t, 1 + VariantIndex<T, Ts...>::value>
+{};
+
+template<typename... Ts>
+class Variant {
+public:
+    template<typename T, typename = typename std::enable_if<!std::is_base_of<Variant, typename std::decay<T>::type>::value>::type>
+    inline Variant(T &&value) :
+        _index(VariantIndex<typename std::decay<T>::type, Ts...>::value)
+    {
+        new (&storage) typename std::decay<T>::type(std::forward<T>(value));
+    }
+
+    inline Variant(const Variant &variant) :
+        _index(variant._index)
+    {
+        static void (*const copyTable[])(void *, const void *) = {copyConstruct<Ts>...};
+        copyTable[_index](&storage, &variant.storage);
+    }
+
+    inline Variant(Variant &&variant) :
+        _index(variant._index)
+    {
+        static void (*const moveTable[])(void *, void *) = {moveConstruct<Ts>...};
+        moveTable[_index](&storage, &variant.storage);
+    }
+
+    inline Variant &operator=(const Variant &variant) {
+        if (this != &variant) {
+            Variant copy(variant);
+            *this = std::move(copy);
+        }
+
+        return *this;
+    }
+
+    inline Variant &operator=(Variant &&variant) {
+        if (this != &variant) {
+            destroy();
+            _index = variant._index;
+
+            static void (*const moveTable[])(void *, void *) = {moveConstruct<Ts>...};
+            moveTable[_index](&storage, &variant.storage);
+        }
+
+        return *this;
+    }
+
+    inline ~Variant() {
+        destroy();
+    }
+
+    inline size_t index() const {
+        return _index;
+    }
+
+    template<typename T>
+    inline bool is() const {
+        return _index == VariantIndex<T, Ts...>::value;
+    }
+
+    template<typename T>
+    inline T &get() {
+        return *reinterpret_cast<T *>(&storage);
+    }
+
+    template<typename T>
+    inline const T &get() const {
+        return *reinterpret_cast<const T *>(&storage);
+    }
+
+    template<typename T>
+    inline T *getIf() {
+        return is<T>() ? &get<T>() : nullptr;
+    }
+
+    template<typename T>
+    inline const T *getIf() const {
+        return is<T>() ? &get<T>() : nullptr;
+    }
+
+    template<typename F>
+    inline auto visit(F &&visitor) -> decltype(visitor(std::declval<typename std::tuple_element<0, std::tuple<Ts...>>::type &>())) {
+        typedef decltype(visitor(std::declval<typename std::tuple_element<0, std::tuple<Ts...>>::type &>())) R;
+        static R (*const visitTable[])(F &, void *) = {visitImpl<R, F, Ts>...};
+        return visitTable[_index](visitor, &storage);
+    }
+
+    template<typename F>
+    inline auto visit(F &&visitor) const -> decltype(visitor(std::declval<const typename std::tuple_element<0, std::tuple<Ts...>>::type &>())) {
+        typedef decltype(visitor(std::declval<const typename std::tuple_element<0, std::tuple<Ts...>>::type &>())) R;
+        static R (*const visitTable[])(F &, const void *) = {visitConstImpl<R, F, Ts>...};
+        return visitTable[_index](visitor, &storage);
+    }
+private:
+    template<typename T>
+    static void copyConstruct(void *destination, const void *source) {
+        new (destination) T(*static_cast<const T *>(source));
+    }
+
+    template<typename T>
+    static void moveConstruct(void *destination, void *source) {
+        new (destination) T(std::move(*static_cast<T *>(source)));
+    }
+
+    template<typename T>
+    static void destroyImpl(void *object) {
+        static_cast<T *>(object)->~T();
+    }
+
+    template<typename R, typename F, typename T>
+    static R visitImpl(F &visitor, void *object) {
+        return visitor(*static_cast<T *>(object));
+    }
+
+    template<typename R, typename F, typename T>
+    static R visitConstImpl(F &visitor, const void *object) {
+        return visitor(*static_cast<const T *>(object));
+    }
+
+    inline void destroy() {
+        static void (*const destroyTable[])(void *) = {destroyImpl<Ts>...};
+        destroyTable[_index](&storage);
+    }
+
+    typename std::aligned_union<0, Ts...>::type storage;
+    size_t _index;
+};
+
+#endif
@@ -1,17 +1,224 @@
 #include "Global.h"
 #include "Compiler.h"
 #include "Diagnostics.h"
+#include "AllocStats.h"
+#include "Batch.h"
+#include "ThreadPool.h"
+#include "Server.h"
+#include <fstream>
 
 const char *listingFileType = "lst";
 
+string replaceFileExtension(const string &filePath, const string &extension) {
+    size_t nameBegin = filePath.find_last_of('/');
+    nameBegin = (nameBegin == string::npos) ? 0 : (nameBegin + 1);
+
+    size_t dotPos = filePath.find_last_of('.');
+    if ((dotPos == string::npos) || (dotPos < nameBegin))
+        return filePath + "." + extension;
+    else
+        return filePath.substr(0, dotPos) + "." + extension;
+}
+
+bool readResponseFile(const string &responseFilePath, vector<string> &sourceFileNames) {
+    std::ifstream responseFile(responseFilePath);
+    if (!responseFile.is_open())
+        return false;
+
+    string line;
+    while (std::getline(responseFile, line)) {
+        size_t begin = line.find_first_not_of(" \t\r");
+        size_t end = line.find_last_not_of(" \t\r");
+
+        if (begin != string::npos)
+            sourceFileNames.push_back(line.substr(begin, end - begin + 1));
+    }
+
+    return true;
+}
+
+CompileOptions resolveFileOptions(CompileOptions options, const string &sourceFileName, const optional<string> &listingFilePath) {
+    if ((options.outputFormat != CompileOptions::OutputFormat::NONE) && options.outputFilePath.empty()) {
+        const map<CompileOptions::OutputFormat, string> extensionMap = {
+            {CompileOptions::OutputFormat::BIN, "bin"},
+            {CompileOptions::OutputFormat::COM, "com"},
+            {CompileOptions::OutputFormat::ELF, "o"},
+            {CompileOptions::OutputFormat::OMF, "obj"},
+            {CompileOptions::OutputFormat::MZ, "exe"}
+        };
+
+        options.outputFilePath = replaceFileExtension(sourceFileName, extensionMap.find(options.outputFormat)->second);
+    }
+
+    if (listingFilePath)
+        options.listingFilePath = listingFilePath;
+    else if ((options.outputFormat == CompileOptions::OutputFormat::NONE) && (!options.isCheckOnly))
+        options.listingFilePath = replaceFileExtension(sourceFileName, listingFileType);
+
+    return options;
+}
+
 int main(int argc, const char **argv) {
-    if (argc < 2)
+    vector<string> sourceFileNames;
+    optional<string> listingFilePath;
+    CompileOptions options;
+    size_t jobCount = ThreadPool::defaultThreadCount();
+    bool isServing = false;
+    optional<string> serveSocketPath;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg(argv[i]);
+        optional<string> inlineValue;
+
+        size_t equalsPos = arg.find('=');
+        if ((arg.compare(0, 2, "--") == 0) && (equalsPos != string::npos)) {
+            inlineValue = arg.substr(equalsPos + 1);
+            arg.erase(equalsPos);
+        }
+
+        if ((arg == "-o") || (arg == "-l") || (arg == "-f") || (arg == "--org") || (arg == "--arch") ||
+            (arg == "--alloc-report") || (arg == "--trace") || (arg == "-j"))
+        {
+            if ((!inlineValue) && (i + 1 == argc)) {
+                printError(string("Error: option \'") + arg + "\' requires a value");
+                return 1;
+            }
+
+            string value = inlineValue ? *inlineValue : string(argv[++i]);
+
+            if (arg == "-o")
+                options.outputFilePath = value;
+            else if (arg == "-l")
+                listingFilePath = value;
+            else if (arg == "--trace")
+                options.traceFilePath = value;
+            else if (arg == "--alloc-report") {
+                if (!AllocStats::isEnabled()) {
+                    printError("Error: allocation accounting requires a build with ALLOC_STATS=1");
+                    return 1;
+                }
+
+                options.allocReportFilePath = value;
+            } else if (arg == "-j") {
+                size_t length = 0;
+                try {
+                    jobCount = std::stoul(value, &length);
+                } catch (std::exception &) {
+                }
+
+                if ((jobCount == 0) || (length != value.size())) {
+                    printError(string("Error: invalid job count \'") + value + "\'");
+                    return 1;
+                }
+            } else if (arg == "-f") {
+                if (value == "bin")
+                    options.outputFormat = CompileOptions::OutputFormat::BIN;
+                else if (value == "com")
+                    options.outputFormat = CompileOptions::OutputFormat::COM;
+                else if (value == "elf")
+                    options.outputFormat = CompileOptions::OutputFormat::ELF;
+                else if (value == "omf")
+                    options.outputFormat = CompileOptions::OutputFormat::OMF;
+                else if (value == "exe")
+                    options.outputFormat = CompileOptions::OutputFormat::MZ;
+                else {
+                    printError(string("Error: unknown output format \'") + value + "\'");
+                    return 1;
+                }
+            } else if (arg == "--arch") {
+                if (value == "16")
+                    options.arch = Compiler::Arch::X86_16;
+                else if (value == "32")
+                    options.arch = Compiler::Arch::X86_32;
+                else {
+                    printError(string("Error: unknown architecture \'") + value + "\'");
+                    return 1;
+                }
+            } else {
+                size_t length = 0;
+                try {
+                    options.origin = std::stoul(value, &length, 0);
+                } catch (std::exception &) {
+                }
+
+                if ((!options.origin) || (length != value.size())) {
+                    printError(string("Error: invalid origin \'") + value + "\'");
+                    return 1;
+                }
+            }
+        } else if (arg == "--serve") {
+            isServing = true;
+            serveSocketPath = inlineValue;
+        } else if (inlineValue) {
+            printError(string("Error: option \'") + arg + "\' does not take a value");
+            return 1;
+        } else if (arg == "--check")
+            options.isCheckOnly = true;
+        else if (arg == "--byte-offsets")
+            options.isReportingOffsets = true;
+        else if (arg == "--time-report")
+            options.isTimeReporting = true;
+        else if (arg == "--stats")
+            options.isPrintingStats = true;
+        else if ((arg.size() > 1) && (arg[0] == '@')) {
+            if (!readResponseFile(arg.substr(1), sourceFileNames)) {
+                printError(string("Error: response file \'") + arg.substr(1) + "\' not found, or permission denied");
+                return 1;
+            }
+        } else
+            sourceFileNames.push_back(arg);
+    }
+
+    if (isServing) {
+        if ((!sourceFileNames.empty()) || (argc > 2)) {
+            printError("Error: --serve can not be combined with other arguments");
+            return 1;
+        }
+
+        try {
+            return serve(serveSocketPath) ? 0 : 1;
+        } catch (std::exception &e) {
+            printError(e.what());
+            return 1;
+        }
+    }
+
+    if (sourceFileNames.empty()) {
         printError("Error: no source file specified");
-    else {
-        string sourceFileName(argv[1]);
+        return 0;
+    }
 
-        Compile(sourceFileName);
+    if (options.isCheckOnly && ((options.outputFormat != CompileOptions::OutputFormat::NONE) || (!options.outputFilePath.empty()) || listingFilePath)) {
+        printError("Error: --check can not be combined with output options");
+        return 1;
     }
 
-    return 0;
+    if ((options.outputFormat == CompileOptions::OutputFormat::NONE) && (!options.outputFilePath.empty()))
+        options.outputFormat = CompileOptions::OutputFormat::BIN;
+
+    if (((options.outputFormat == CompileOptions::OutputFormat::ELF) ||
+         (options.outputFormat == CompileOptions::OutputFormat::OMF) ||
+         (options.outputFormat == CompileOptions::OutputFormat::MZ)) && options.origin)
+    {
+        printError("Error: origin can not be set for relocatable output");
+        return 1;
+    }
+
+    if (sourceFileNames.size() > 1) {
+        if ((!options.outputFilePath.empty()) || listingFilePath || options.traceFilePath || options.allocReportFilePath) {
+            printError("Error: -o, -l, --trace and --alloc-report can not be used with several source files");
+            return 1;
+        }
+
+        vector<BatchJob> jobs;
+        for (auto it = sourceFileNames.begin(); it != sourceFileNames.end(); ++it)
+            jobs.push_back({*it, resolveFileOptions(options, *it, listingFilePath)});
+
+        return compileBatch(jobs, jobCount) ? 0 : 1;
+    }
+
+    ThreadPool threadPool(jobCount);
+    options.threadPool = &threadPool;
+
+    return Compile(sourceFileNames[0], resolveFileOptions(options, sourceFileNames[0], listingFilePath)) ? 0 : 1;
 }
@@ -0,0 +1,11 @@
+CODE SEGMENT
+    ASSUME CS:CODE, DS:CODE
+START:
+    PUSH DWORD PTR [EAX+ECX*4+10]
+    MOV GS:[EAX+300], EBX
+    JBE START
+    NOT AL
+    V1 DD V1
+    DB 'text', 0
+CODE ENDS
+END
@@ -0,0 +1,7 @@
+A SEGMENT
+  DD W
+A ENDS
+B SEGMENT
+W DD 1
+B ENDS
+END
@@ -0,0 +1,10 @@
+CODE SEGMENT
+    ASSUME CS:CODE, DS:CODE
+START:
+    PUSH DWORD PTR V1
+    MOV MSG[BX], CL
+    JBE START
+    V1 DW V1
+    MSG DB 'hi', 0
+CODE ENDS
+END START
@@ -0,0 +1,7 @@
+A SEGMENT
+JBE Y
+A ENDS
+B SEGMENT
+Y: DAA
+B ENDS
+END
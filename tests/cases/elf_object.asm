@@ -0,0 +1,20 @@
+PUBLIC START, EXIT
+DATA SEGMENT
+COUNT DD 5
+TABLE DB 1, 2, 3
+DATA ENDS
+CODE SEGMENT
+START:
+    MOV [TABLE], AL
+    PUSH DWORD PTR COUNT
+    JBE NEXT
+    DAA
+NEXT:
+    JBE EXIT
+CODE ENDS
+TEXT SEGMENT
+EXIT:
+    NOT EBX
+    JBE START
+TEXT ENDS
+END
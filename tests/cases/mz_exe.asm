@@ -0,0 +1,11 @@
+DATA SEGMENT
+MSG DB 1, 2, 3
+DATA ENDS
+CODE SEGMENT
+ASSUME CS:CODE, DS:DATA
+START:
+    MOV MSG[BX], CL
+    JBE START
+    DAA
+CODE ENDS
+END START
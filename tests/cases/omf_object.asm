@@ -0,0 +1,15 @@
+PUBLIC START
+DATA SEGMENT
+COUNT DD 5
+TABLE DB 1, 2, 3
+DATA ENDS
+CODE SEGMENT
+START:
+    MOV [TABLE], AL
+    PUSH DWORD PTR COUNT
+    JBE NEXT
+    DAA
+NEXT:
+    JBE START
+CODE ENDS
+END START
@@ -0,0 +1,6 @@
+PUBLIC MAIN
+CODE SEGMENT
+START:
+    DAA
+CODE ENDS
+END
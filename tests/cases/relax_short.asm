@@ -0,0 +1,27 @@
+CODE SEGMENT
+ST:
+    JBE FAR1
+    MOV [EAX+ECX*4+10], EBX
+    JBE FAR1
+    MOV [EAX+ECX*4+10], EBX
+    JBE FAR1
+    MOV [EAX+ECX*4+10], EBX
+    JBE FAR1
+    MOV [EAX+ECX*4+10], EBX
+    JBE FAR1
+    MOV [EAX+ECX*4+10], EBX
+    JBE FAR1
+    MOV [EAX+ECX*4+10], EBX
+    JBE FAR1
+    MOV [EAX+ECX*4+10], EBX
+    JBE FAR1
+    MOV [EAX+ECX*4+10], EBX
+    JBE FAR1
+    MOV [EAX+ECX*4+10], EBX
+    JBE FAR1
+    MOV [EAX+ECX*4+10], EBX
+FAR1:
+    DAA
+    JBE ST
+CODE ENDS
+END
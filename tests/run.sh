@@ -0,0 +1,57 @@
+#!/bin/sh
+#
+# Golden-output tests. Each case in tests/cases/ is a NAME.args file holding the
+# command line passed to tas, with SOURCE replaced by NAME.asm and OUTPUT by a
+# scratch output path. NAME.stdin, if present, is fed to standard input.
+# Standard output, standard error and the exit status are compared with
+# NAME.out, and the written OUTPUT file with NAME.golden when it exists.
+#
+# Run with UPDATE=1 to rewrite the expected files from the current build.
+
+tas=${1:-build/tas}
+cases=$(dirname "$0")/cases
+scratch=$(mktemp -d)
+trap 'rm -rf "$scratch"' EXIT
+
+passed=0
+failed=0
+
+for args in "$cases"/*.args; do
+    name=$(basename "$args" .args)
+    stdin="$cases/$name.stdin"
+    [ -f "$stdin" ] || stdin=/dev/null
+
+    output="$scratch/$name.output"
+    command=$(sed -e "s|SOURCE|$cases/$name.asm|g" -e "s|OUTPUT|$output|g" "$args")
+
+    $tas $command < "$stdin" > "$scratch/$name.out" 2>&1
+    echo "exit $?" >> "$scratch/$name.out"
+
+    if [ -n "$UPDATE" ]; then
+        cp "$scratch/$name.out" "$cases/$name.out"
+        if [ -f "$output" ]; then
+            cp "$output" "$cases/$name.golden"
+        fi
+    fi
+
+    status=ok
+    if ! cmp -s "$scratch/$name.out" "$cases/$name.out"; then
+        status=FAIL
+        diff "$cases/$name.out" "$scratch/$name.out" | head -20
+    fi
+
+    if [ -f "$cases/$name.golden" ] && ! cmp -s "$output" "$cases/$name.golden"; then
+        status=FAIL
+        cmp "$output" "$cases/$name.golden"
+    fi
+
+    echo "$status $name"
+    if [ "$status" = ok ]; then
+        passed=$((passed + 1))
+    else
+        failed=$((failed + 1))
+    fi
+done
+
+echo "$passed passed, $failed failed"
+[ "$failed" -eq 0 ]